@@ -0,0 +1,187 @@
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <regex>
+#include <string>
+#include <vector>
+
+
+//------------------------------------------------------------------------------
+//  Code generation report for the old-vs-new compare() pairs in the demos:
+//  when "old" and "new" show the same history but time differently, this
+//  shows how their generated code differs.
+//
+//  This program is plain C++, build it with any compiler. Then compile a demo
+//  to assembly with the prototype compiler and run the report, e.g.:
+//
+//      clang++ -std=c++20 -O2 -DCOMPARE_CODEGEN -S demo-in-2.cpp -o demo-in-2.s
+//      asm-diff demo-in-2.cpp demo-in-2.s
+//
+//  Each compare(name, old, new) call in main contributes two lambdas, in
+//  order, and COMPARE_CODEGEN keeps each one in its own out_of_line<lambda>
+//  function. For each pair the report shows the instruction count, call
+//  count and stack adjustment of both, and the instructions that differ.
+//  The callees are still inlined into the lambdas as usual, so this covers
+//  the parameter passing as well as the call.
+//
+//  gcc's identical code folding (on at -O2) can merge lambdas with the same
+//  code and leave out_of_line as a single jmp to the merged function; the
+//  report follows such a jmp and reports the function it lands in, marked
+//  "(in <symbol>)". Add -fno-ipa-icf to keep every lambda separate instead.
+//  gcc clones with .isra.N/.constprop.N/.part.N suffixes are also accepted.
+//
+//------------------------------------------------------------------------------
+
+struct function {
+    std::vector<std::string> instructions;
+    int calls = 0;
+    int stack = 0;
+    std::string via;        // set if this is the target of a jmp-only body
+};
+
+//  Every function in the assembly, by symbol
+std::map<std::string, function> read_functions(std::istream& in) {
+    auto const label = std::regex(R"(^([A-Za-z_$][\w.$]*):)");
+    auto const stack = std::regex(R"(sub[lq]?\s+(?:\$(\d+),\s*%[re]sp|[re]sp,\s*(\d+)))");
+
+    auto ret     = std::map<std::string, function>{};
+    auto current = (function*)nullptr;
+    auto line    = std::string{};
+    while (std::getline(in, line)) {
+        auto m = std::smatch{};
+        if (std::regex_search(line, m, label)) {
+            current = &ret[m[1]];
+        }
+        else if (current && (line.find(".cfi_endproc") != line.npos || line.find(".size") != line.npos)) {
+            current = nullptr;
+        }
+        else if (current && !line.empty() && std::isspace((unsigned char)line[0])) {
+            auto first = line.find_first_not_of(" \t");
+            if (first == line.npos || line[first] == '.' || line[first] == '#') { continue; }
+            auto insn = line.substr(first);
+            std::replace(insn.begin(), insn.end(), '\t', ' ');
+            if (insn.starts_with("call") || insn.starts_with("jmp _") || insn.starts_with("bl ")) {
+                ++current->calls;
+            }
+            if (std::regex_search(insn, m, stack)) {
+                current->stack += std::stoi(m[1].matched ? m[1].str() : m[2].str());
+            }
+            current->instructions.push_back(insn);
+        }
+    }
+    return ret;
+}
+
+//  If f's whole body is a tail call to another function in the assembly,
+//  that function (repeatedly), else f. gcc's identical code folding does
+//  this to out_of_line: it merges lambdas with the same code into one, e.g.
+//  _ZZ4mainENKUlvE_clEv.constprop.0, and each out_of_line<lambda> becomes a
+//  single jmp to it, which would otherwise be reported as "1 instructions".
+function follow(std::map<std::string, function> const& functions, function f) {
+    auto const jmp = std::regex(R"(^(?:jmp|b)\s+([A-Za-z_$][\w.$]*)$)");
+    for (auto hops = 0; hops < 8 && f.instructions.size() == 1; ++hops) {
+        auto m = std::smatch{};
+        if (!std::regex_match(f.instructions[0], m, jmp)) { break; }
+        auto target = functions.find(m[1]);
+        if (target == functions.end()) { break; }
+        f = target->second;
+        f.via = target->first;
+    }
+    return f;
+}
+
+//  The lambdas in main, by their index in source order, each followed
+//  through any jmp-only body to the code that actually runs
+std::map<int, function> read_lambdas(std::istream& in) {
+    //  clang: out_of_line<main::$_0>    gcc: out_of_line<main::{lambda()#1}>,
+    //  possibly as a gcc clone with an .isra.N/.constprop.N/.part.N suffix
+    auto const lambda = std::regex(R"(^_Z11out_of_lineIZ4mainE(?:3\$_(\d+)|UlvE(\d*)_)EvT_((?:\.(?:isra|constprop|part)\.\d+)*)$)");
+
+    auto functions = read_functions(in);
+    auto ret       = std::map<int, function>{};
+    for (auto const& [symbol, f] : functions) {
+        auto m = std::smatch{};
+        if (!std::regex_match(symbol, m, lambda)) { continue; }
+        auto index = m[1].matched ? std::stoi(m[1]) : m[2].length() ? std::stoi(m[2])+1 : 0;
+        //  Prefer the function itself over a clone of it, if both are there
+        if (m[3].length() == 0 || !ret.contains(index)) {
+            ret[index] = follow(functions, f);
+        }
+    }
+    return ret;
+}
+
+//  The names passed to compare(), in source order
+std::vector<std::string> read_names(std::istream& in) {
+    auto const call = std::regex(R"(compare\(\s*\"([^\"]*)\")");
+    auto source = std::string(std::istreambuf_iterator<char>(in), {});
+    auto ret    = std::vector<std::string>{};
+    for (auto i = std::sregex_iterator(source.begin(), source.end(), call); i != std::sregex_iterator{}; ++i) {
+        ret.push_back((*i)[1]);
+    }
+    return ret;
+}
+
+//  Print the instructions only in "old" as "-" and only in "new" as "+"
+//  (a simple LCS diff, the functions are small)
+void diff(std::vector<std::string> const& a, std::vector<std::string> const& b) {
+    auto lcs = std::vector(a.size()+1, std::vector<int>(b.size()+1));
+    for (auto i = a.size(); i-- > 0; ) {
+        for (auto j = b.size(); j-- > 0; ) {
+            lcs[i][j] = a[i] == b[j] ? lcs[i+1][j+1]+1 : std::max(lcs[i+1][j], lcs[i][j+1]);
+        }
+    }
+    auto i = std::size_t{0}, j = std::size_t{0};
+    while (i < a.size() || j < b.size()) {
+        if (i < a.size() && j < b.size() && a[i] == b[j])           { ++i; ++j; }
+        else if (j < b.size() && (i == a.size() || lcs[i][j+1] >= lcs[i+1][j]))
+                                                                    { std::cout << "    + " << b[j++] << "\n"; }
+        else                                                        { std::cout << "    - " << a[i++] << "\n"; }
+    }
+}
+
+int main(int argc, char* argv[]) {
+    if (argc != 3) {
+        std::cerr << "usage: " << argv[0] << " <demo .cpp> <its assembly .s>\n";
+        return EXIT_FAILURE;
+    }
+    auto source = std::ifstream(argv[1]);
+    auto assembly = std::ifstream(argv[2]);
+    if (!source || !assembly) {
+        std::cerr << "cannot open input\n";
+        return EXIT_FAILURE;
+    }
+    auto names   = read_names(source);
+    auto lambdas = read_lambdas(assembly);
+
+    for (auto n = 0; n < int(names.size()); ++n) {
+        auto old_it = lambdas.find(2*n), new_it = lambdas.find(2*n+1);
+        if (old_it == lambdas.end() || new_it == lambdas.end()) {
+            std::cerr << "no out_of_line<lambda> code for \"" << names[n] << "\" in " << argv[2]
+                      << " -- was the demo compiled with -DCOMPARE_CODEGEN -S?\n";
+            return EXIT_FAILURE;
+        }
+        auto const& old_f = old_it->second;
+        auto const& new_f = new_it->second;
+        std::cout << names[n]
+                  << "\n  old: " << old_f.instructions.size() << " instructions, "
+                                 << old_f.calls << " calls, "
+                                 << old_f.stack << " bytes stack"
+                                 << (old_f.via.empty() ? "" : " (in " + old_f.via + ")")
+                  << "\n  new: " << new_f.instructions.size() << " instructions, "
+                                 << new_f.calls << " calls, "
+                                 << new_f.stack << " bytes stack"
+                                 << (new_f.via.empty() ? "" : " (in " + new_f.via + ")") << "\n";
+        if (!old_f.via.empty() && old_f.via == new_f.via) {
+            std::cout << "    (identical, folded into one function)\n";
+        } else if (old_f.instructions == new_f.instructions) {
+            std::cout << "    (identical)\n";
+        } else {
+            diff(old_f.instructions, new_f.instructions);
+        }
+        std::cout << "\n";
+    }
+}
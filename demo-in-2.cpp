@@ -43,9 +43,17 @@ void new_in(in String s) {
 //
 //------------------------------------------------------------------------------
 
+//  Build with -DCOMPARE_CODEGEN -S to keep each old/new lambda in its own
+//  function, so that asm-diff can report how their generated code differs
+#ifdef COMPARE_CODEGEN
+[[gnu::noinline]] void out_of_line(auto f) { f(); }
+#else
+void out_of_line(auto f) { f(); }
+#endif
+
 void compare(auto name, auto f1, auto f2) {
-    std::cout << name << "\n  old: " << hst::run_history(f1)
-                      << "\n  new: " << hst::run_history(f2) << "\n\n";
+    std::cout << name << "\n  old: " << hst::run_history([=]{ out_of_line(f1); })
+                      << "\n  new: " << hst::run_history([=]{ out_of_line(f2); }) << "\n\n";
 }
 
 int main() {
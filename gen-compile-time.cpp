@@ -0,0 +1,190 @@
+#include <charconv>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <regex>
+#include <sstream>
+#include <string>
+#include <string_view>
+
+
+//------------------------------------------------------------------------------
+//  Compile-time comparison generator: emits one TU that declares N "in"
+//  functions and calls each of them with lvalue/xvalue/prvalue arguments of
+//  several types, written either today's way (demo-in-4.cpp's three
+//  requires-constrained "old_in" overloads) or with "in auto" ("new_in").
+//
+//  This program is plain C++, build it with any compiler. Then compile each
+//  generated TU with the prototype compiler and compare, e.g.:
+//
+//      gen-compile-time old 2000 > old.cpp
+//      gen-compile-time new 2000 > new.cpp
+//      /usr/bin/time -v clang++ -std=c++20 -c -ftime-trace old.cpp
+//      /usr/bin/time -v clang++ -std=c++20 -c -ftime-trace new.cpp
+//
+//  -ftime-trace writes old.json/new.json (front-end time and per-template
+//  instantiation events, viewable in chrome://tracing or Speedscope), and
+//  "Maximum resident set size" from time -v is the peak compiler memory.
+//
+//  Or let it do all of that and print the results side by side:
+//
+//      gen-compile-time compare 2000 [compiler, default clang++]
+//
+//  which writes gen-compile-time-old.cpp and gen-compile-time-new.cpp to the
+//  current directory, compiles each under /usr/bin/time -v with
+//  -ftime-trace, and prints the front-end time and the function and class
+//  template instantiation counts (the "Total Frontend", "Total
+//  InstantiateFunction" and "Total InstantiateClass" events of the trace)
+//  and the peak memory of each. The traces are left next to the sources.
+//
+//------------------------------------------------------------------------------
+
+constexpr std::string_view prologue = R"(#include <https://raw.githubusercontent.com/hsutter/misc/master/hst.h>
+#include <string>
+#include <vector>
+
+void copy_from(auto...) { }
+
+using String = hst::noisy<std::string>;
+
+struct Record {
+    String name;
+    std::vector<int> values;
+    int id = 0;
+};
+
+template<typename T> constexpr bool should_pass_by_value_v
+    = std::is_trivially_copyable_v<T> && sizeof(T) < 8;
+)";
+
+//  The argument types each function is called with, as "type" and "lvalue
+//  initializer" pairs
+struct arg_type { std::string_view type, init; };
+constexpr arg_type arg_types[] = {
+    { "int",              "0"         },
+    { "String",           "{}"        },
+    { "std::vector<int>", "{1, 2, 3}" },
+    { "Record",           "{}"        },
+};
+
+void emit_old(std::ostream& out, int i) {
+    out << "\ntemplate<typename T>\n"
+           "    requires should_pass_by_value_v<T>\n"
+           "void old_in_" << i << "(T t) { copy_from(t); }\n"
+           "template<typename T>\n"
+           "    requires (!should_pass_by_value_v<T>)\n"
+           "void old_in_" << i << "(const T& t) { copy_from(t); }\n"
+           "template<typename T>\n"
+           "    requires (!should_pass_by_value_v<T> && !std::is_reference_v<T>)\n"
+           "void old_in_" << i << "(T&& t) { copy_from(std::forward<T>(t)); }\n";
+}
+
+void emit_new(std::ostream& out, int i) {
+    out << "\nvoid new_in_" << i << "(in auto t) { copy_from(t); }\n";
+}
+
+void emit_calls(std::ostream& out, std::string_view style, int i) {
+    auto const& a = arg_types[i % std::size(arg_types)];
+    out << "\nvoid call_" << i << "() {\n"
+        << "    " << a.type << " x = " << a.init << ";\n"
+        << "    " << style << "_in_" << i << "(x);\n"
+        << "    " << style << "_in_" << i << "(std::move(x));\n"
+        << "    " << style << "_in_" << i << "(" << a.type << "{});\n"
+        << "}\n";
+}
+
+void emit_program(std::ostream& out, std::string_view style, int n) {
+    out << prologue;
+    for (int i = 0; i < n; ++i) {
+        if (style == "old") { emit_old(out, i); }
+        else                { emit_new(out, i); }
+        emit_calls(out, style, i);
+    }
+    out << "\nint main() { }\n";
+}
+
+
+//------------------------------------------------------------------------------
+//  compare mode
+
+struct compile_stats {
+    double frontend_ms    = 0;
+    long   functions      = 0;      // function template instantiations
+    long   classes        = 0;      // class template instantiations
+    long   peak_kb        = 0;
+};
+
+std::string read_file(std::string const& path) {
+    auto in = std::ifstream(path);
+    return std::string(std::istreambuf_iterator<char>(in), {});
+}
+
+//  The first number matched by group 1 of re in text, or 0
+long find_number(std::string const& text, std::regex const& re) {
+    auto m = std::smatch{};
+    return std::regex_search(text, m, re) ? std::stol(m[1]) : 0;
+}
+
+//  Generate one style, compile it, and collect its trace and time -v results;
+//  returns false if it does not compile
+bool compile(std::string_view style, int n, std::string const& compiler, compile_stats& stats) {
+    auto base = "gen-compile-time-" + std::string(style);
+    {
+        auto out = std::ofstream(base + ".cpp");
+        emit_program(out, style, n);
+    }
+    auto command = "/usr/bin/time -v -o " + base + ".time " + compiler
+                 + " -std=c++20 -c -ftime-trace " + base + ".cpp -o " + base + ".o";
+    if (std::system(command.c_str()) != 0) {
+        std::cerr << "failed: " << command << "\n";
+        return false;
+    }
+
+    //  The trace's events are written as {..."dur":N,"name":"...","args":{...}}
+    auto trace = read_file(base + ".json");
+    stats.frontend_ms = find_number(trace, std::regex(R"re("dur":(\d+),"name":"Total Frontend")re")) / 1000.0;
+    stats.functions   = find_number(trace, std::regex(R"re("name":"Total InstantiateFunction","args":\{"count":(\d+))re"));
+    stats.classes     = find_number(trace, std::regex(R"re("name":"Total InstantiateClass","args":\{"count":(\d+))re"));
+    stats.peak_kb     = find_number(read_file(base + ".time"), std::regex(R"(Maximum resident set size \(kbytes\): (\d+))"));
+    return true;
+}
+
+int compare(int n, std::string const& compiler) {
+    auto old_stats = compile_stats{}, new_stats = compile_stats{};
+    if (!compile("old", n, compiler, old_stats) || !compile("new", n, compiler, new_stats)) {
+        return EXIT_FAILURE;
+    }
+    auto row = [](std::string_view name, auto o, auto n) {
+        std::cout << std::left << std::setw(28) << name << std::right
+                  << std::setw(12) << o << std::setw(12) << n << "\n";
+    };
+    row("", "old", "new");
+    row("front end (ms)",             old_stats.frontend_ms, new_stats.frontend_ms);
+    row("function instantiations",    old_stats.functions,   new_stats.functions);
+    row("class instantiations",       old_stats.classes,     new_stats.classes);
+    row("peak memory (KB)",           old_stats.peak_kb,     new_stats.peak_kb);
+    return EXIT_SUCCESS;
+}
+
+
+int main(int argc, char* argv[]) {
+    auto style = std::string_view{ argc > 1 ? argv[1] : "" };
+    auto count = std::string_view{ argc > 2 ? argv[2] : "" };
+    auto n     = 0;
+    auto [end, ec] = std::from_chars(count.data(), count.data() + count.size(), n);
+    auto valid = ec == std::errc{} && end == count.data() + count.size() && n >= 1;
+    if (!valid
+        || (style == "compare" ? argc != 3 && argc != 4 : argc != 3)
+        || (style != "old" && style != "new" && style != "compare")) {
+        std::cerr << "usage: " << argv[0] << " old|new <number of functions>\n"
+                     "       " << argv[0] << " compare <number of functions> [compiler]\n"
+                     "       the number of functions must be at least 1\n";
+        return EXIT_FAILURE;
+    }
+
+    if (style == "compare") {
+        return compare(n, argc == 4 ? argv[3] : "clang++");
+    }
+    emit_program(std::cout, style, n);
+}
@@ -0,0 +1,415 @@
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+
+//------------------------------------------------------------------------------
+//  Random parameter-kind test generator: emits one test program whose
+//  functions take random mixes of in/inout/move/out String parameters and
+//  whose bodies are random nests of branches and loops, plus random
+//  lvalue/xvalue/prvalue call sites. Each function is also emitted today's
+//  way (const&/&&/& parameters, with std::move written by hand at each last
+//  use), and every call site is a test.run comparing the two histories,
+//  each of which ends with the number of allocations the call made.
+//
+//  This program is plain C++, build it with any compiler. The programs it
+//  emits use "in"/"inout"/"move"/"out" and include hst.h by URL, so build
+//  those with the prototype compiler. Usage:
+//
+//      gen-fuzz <seed> [functions] [max depth] [max statements per block]
+//      gen-fuzz --reduce <check command> <seed> [functions] [max depth] [max statements per block]
+//
+//  A run is fully determined by its arguments, so to run many programs in
+//  parallel just vary the seed, e.g.:
+//
+//      seq 1 10000 | xargs -P$(nproc) -I{} sh -c 'gen-fuzz {} > f{}.cpp &&
+//          clang++ -std=c++20 f{}.cpp -o f{} && ./f{} > f{}.txt'
+//
+//  To minimize a failing seed, rerun it with --reduce and a check command
+//  that is given the path of a candidate program and exits with 0 if that
+//  program still shows the mismatch (and nonzero otherwise, including if it
+//  doesn't compile). The reducer regenerates the same program, then deletes
+//  functions, call sites and statements one at a time, keeping each
+//  deletion that still fails, until nothing more can go; it prints the
+//  minimal program. Each reduction works in its own
+//  gen-fuzz-reduce-<seed>-XXXXXX.cpp in the current directory, so several
+//  can run in parallel; the file is removed at the end.
+//
+//------------------------------------------------------------------------------
+
+enum class kind { in, inout, move, out };
+
+struct stmt {
+    enum { use, modify, branch, loop } what;
+    int  param = 0;             // use, modify
+    int  n     = 0;             // branch: condition bit, loop: iteration count
+    bool last  = false;         // use: this is a definite last use
+    bool keep  = false;         // required for the program to be valid, never reduced
+    std::vector<stmt> body, else_body;
+};
+
+//  Each argument's value category (0 lvalue, 1 xvalue, 2 prvalue), and the
+//  branch condition bits
+struct call_site {
+    std::vector<int> category;
+    unsigned bits = 0;
+};
+
+struct function {
+    int number = 0;
+    std::vector<kind> params;
+    std::vector<stmt> body;
+    std::vector<call_site> sites;
+};
+
+struct generator {
+    std::mt19937 rng;
+    int max_depth, max_stmts;
+
+    int pick(int n) { return std::uniform_int_distribution<>(0, n-1)(rng); }
+
+    std::vector<stmt> block(function const& f, int depth) {
+        auto ret = std::vector<stmt>{};
+        for (auto i = 1 + pick(max_stmts); i > 0; --i) {
+            auto choice = pick(depth < max_depth ? 4 : 2);
+            auto s      = stmt{};
+            s.param     = pick(int(f.params.size()));
+            auto k      = f.params[s.param];
+            if (choice == 0 || (choice == 1 && (k == kind::in || k == kind::move))) {
+                s.what = stmt::use;
+            } else if (choice == 1) {
+                s.what = stmt::modify;
+            } else if (choice == 2) {
+                s.what      = stmt::branch;
+                s.n         = pick(8);
+                s.body      = block(f, depth+1);
+                s.else_body = block(f, depth+1);
+            } else {
+                s.what = stmt::loop;
+                s.n    = pick(3);
+                s.body = block(f, depth+1);
+            }
+            ret.push_back(std::move(s));
+        }
+        return ret;
+    }
+
+    function make_function(int number, int max_params) {
+        auto f = function{};
+        f.number = number;
+        for (auto i = 1 + pick(max_params); i > 0; --i) {
+            f.params.push_back(kind(pick(4)));
+        }
+        f.body = block(f, 0);
+
+        //  A "move" parameter must be moved from on every path, so end with a use
+        for (auto p = 0; p < int(f.params.size()); ++p) {
+            if (f.params[p] == kind::move) {
+                auto s  = stmt{};
+                s.what  = stmt::use;
+                s.param = p;
+                s.keep  = true;
+                f.body.push_back(std::move(s));
+            }
+        }
+
+        //  Pick each argument's value category, as allowed by its parameter kind
+        for (auto site = 0; site < 3; ++site) {
+            auto c = call_site{};
+            for (auto k : f.params) {
+                c.category.push_back(
+                    k == kind::inout || k == kind::out ? 0
+                  : k == kind::move                    ? 1 + pick(2)
+                  :                                      pick(3)
+                );
+            }
+            c.bits = unsigned(pick(256));
+            f.sites.push_back(std::move(c));
+        }
+        return f;
+    }
+};
+
+//  Mark the uses of parameter p that are definite last uses: ones with no
+//  later use of p on any path. Uses inside a loop are never last uses, since
+//  the loop can run again. That is the same range-for rule as for
+//  stage_elements in test-in-ranges.cpp: the generated loops use p itself in
+//  their body, like a use of "b" in its loop body, never an element variable
+//  that is fresh on each iteration. Returns whether the block uses p at all.
+bool mark_last_uses(std::vector<stmt>& block, int p, bool later) {
+    auto any = false;
+    for (auto s = block.rbegin(); s != block.rend(); ++s) {
+        auto used = false;
+        switch (s->what) {
+        break;case stmt::use:
+            if (s->param == p) { s->last = !later; used = true; }
+        break;case stmt::modify:
+            used = s->param == p;
+        break;case stmt::branch:
+            used =  mark_last_uses(s->body,      p, later);
+            used =  mark_last_uses(s->else_body, p, later) || used;
+        break;case stmt::loop:
+            used = mark_last_uses(s->body, p, true);
+        }
+        later = later || used;
+        any   = any   || used;
+    }
+    return any;
+}
+
+//  Whether the block uses parameter p at all
+bool uses(std::vector<stmt> const& block, int p) {
+    for (auto const& s : block) {
+        if ((s.what == stmt::use || s.what == stmt::modify) && s.param == p) { return true; }
+        if (uses(s.body, p) || uses(s.else_body, p))                        { return true; }
+    }
+    return false;
+}
+
+//  Emit a body; "rvalue" says which parameters are bound to rvalues in
+//  today's spelling, where the last use has to say std::move explicitly
+void emit_block(std::ostream& out, std::vector<stmt> const& block, int indent,
+                std::vector<bool> const* rvalue) {
+    auto pad = std::string(indent*4, ' ');
+    for (auto const& s : block) {
+        auto name = "p" + std::to_string(s.param);
+        switch (s.what) {
+        break;case stmt::use:
+            if (rvalue && s.last && (*rvalue)[s.param]) {
+                out << pad << "copy_from(std::move(" << name << "));\n";
+            } else {
+                out << pad << "copy_from(" << name << ");\n";
+            }
+        break;case stmt::modify:
+            out << pad << "modify(" << name << ");\n";
+        break;case stmt::branch:
+            out << pad << "if (bits & " << (1u << s.n) << "u) {\n";
+            emit_block(out, s.body, indent+1, rvalue);
+            out << pad << "} else {\n";
+            emit_block(out, s.else_body, indent+1, rvalue);
+            out << pad << "}\n";
+        break;case stmt::loop:
+            //  Named by depth, so that nested loops don't shadow each other
+            auto k = "k" + std::to_string(indent);
+            out << pad << "for (int " << k << " = 0; " << k << " < " << s.n << "; ++" << k << ") {\n";
+            emit_block(out, s.body, indent+1, rvalue);
+            out << pad << "}\n";
+        }
+    }
+}
+
+void emit_params(std::ostream& out, function const& f, std::vector<bool> const* rvalue) {
+    for (auto p = 0; p < int(f.params.size()); ++p) {
+        if (!rvalue) {
+            constexpr char const* spelling[] = { "in", "inout", "move", "out" };
+            out << spelling[int(f.params[p])] << " String";
+        } else if (f.params[p] == kind::inout || f.params[p] == kind::out) {
+            out << "String&";
+        } else {
+            out << ((*rvalue)[p] ? "String&&" : "const String&");
+        }
+        //  Unnamed if unused, so that the output is warning-clean
+        out << (f.params[p] == kind::out || uses(f.body, p) ? " p" : " /*p") << p
+            << (f.params[p] == kind::out || uses(f.body, p) ? ", " : "*/, ");
+    }
+    out << "unsigned bits";
+}
+
+void emit_function(std::ostream& out, function const& f, std::string const& name,
+                   std::vector<bool> const* rvalue) {
+    out << "\nvoid " << name << "(";
+    emit_params(out, f, rvalue);
+    out << ") {\n"
+           "    (void)bits;\n";
+    for (auto p = 0; p < int(f.params.size()); ++p) {
+        if (f.params[p] == kind::out) {
+            out << "    p" << p << " = String();\n";
+        }
+    }
+    emit_block(out, f.body, 1, rvalue);
+    out << "}\n";
+}
+
+void emit_program(std::ostream& out, std::vector<function> functions, std::string const& origin) {
+    out << "#include <https://raw.githubusercontent.com/hsutter/misc/master/hst.h>\n"
+           "#include <cstdlib>\n"
+           "#include <iostream>\n"
+           "#include <new>\n"
+           "#include <string>\n\n"
+           "//  Generated by: gen-fuzz" << origin << "\n\n"
+           "template<typename T>\n"
+           "void copy_from(T) { }\n\n"
+           "using String = hst::noisy<std::string>;\n"
+           "void modify(String& t) { t.t.append(\"xyzzy \"); }\n\n"
+           "std::size_t allocations = 0;\n"
+           "void* operator new(std::size_t n) {\n"
+           "    ++allocations;\n"
+           "    if (auto p = std::malloc(n ? n : 1)) { return p; }\n"
+           "    throw std::bad_alloc();\n"
+           "}\n"
+           "void operator delete(void* p) noexcept { std::free(p); }\n"
+           "void operator delete(void* p, std::size_t) noexcept { std::free(p); }\n\n"
+           "//  Adds the number of allocations f() makes to the history; the history\n"
+           "//  is reserved first, so that its own growth isn't counted\n"
+           "void count_allocations(auto f) {\n"
+           "    hst::history.reserve(hst::history.size() + 4096);\n"
+           "    auto before = allocations;\n"
+           "    f();\n"
+           "    hst::history += \"allocations:\" + std::to_string(allocations - before) + \" \";\n"
+           "}\n";
+
+    auto tests = std::string{};
+    for (auto& f : functions) {
+        for (auto p = 0; p < int(f.params.size()); ++p) {
+            mark_last_uses(f.body, p, false);
+        }
+        auto name = "f" + std::to_string(f.number);
+        emit_function(out, f, name + "_new", nullptr);
+
+        for (auto site = 0; site < int(f.sites.size()); ++site) {
+            auto const& c = f.sites[site];
+            auto rvalue = std::vector<bool>{};
+            auto locals = std::string{}, args = std::string{}, results = std::string{};
+            for (auto p = 0; p < int(f.params.size()); ++p) {
+                auto arg = "a" + std::to_string(p);
+                auto cat = c.category[p];
+                rvalue.push_back(cat != 0);
+                if (cat != 2) { locals += "String " + arg + "; "; }
+                args += cat == 0 ? arg
+                      : cat == 1 ? "std::move(" + arg + ")"
+                      :            std::string("String()");
+                args += ", ";
+                if (cat == 0) { results += "hst::history += " + arg + ".t; "; }
+            }
+            auto old_name = name + "_old_" + std::to_string(site);
+            emit_function(out, f, old_name, &rvalue);
+
+            auto bits = std::to_string(c.bits) + "u";
+            tests += "\n    test.run(\n"
+                     "        \"" + name + " call " + std::to_string(site) + "\",\n"
+                     "        []{ " + locals + "count_allocations([&]{ " + name + "_new(" + args + bits + "); }); " + results + "},\n"
+                     "        []{ " + locals + "count_allocations([&]{ " + old_name + "(" + args + bits + "); }); " + results + "});\n";
+        }
+    }
+
+    out << "\nint main() {\n"
+           "    hst::tester test(\"generated parameter cases\");\n"
+        << tests
+        << "\n    std::cout << test.summary();\n"
+           "}\n";
+}
+
+
+//------------------------------------------------------------------------------
+//  Reduction
+
+//  Delete the n-th (in preorder) statement that isn't required; returns
+//  whether there was one to delete
+bool delete_stmt(std::vector<stmt>& block, int& n) {
+    for (auto s = block.begin(); s != block.end(); ++s) {
+        if (!s->keep && n-- == 0) {
+            block.erase(s);
+            return true;
+        }
+        if (delete_stmt(s->body, n) || delete_stmt(s->else_body, n)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+struct reducer {
+    std::string check, origin, path;
+
+    bool still_fails(std::vector<function> const& functions) const {
+        {
+            auto out = std::ofstream(path);
+            emit_program(out, functions, origin);
+        }
+        return std::system((check + " " + path).c_str()) == 0;
+    }
+
+    std::vector<function> reduce(std::vector<function> functions) const {
+        if (!still_fails(functions)) {
+            std::cerr << "the original program does not fail the check, nothing to reduce\n";
+            return functions;
+        }
+        for (auto progress = true; progress; ) {
+            progress = false;
+
+            //  Try deleting each function, then each call site, then each statement
+            for (auto i = std::size_t{0}; i < functions.size() && functions.size() > 1; ) {
+                auto candidate = functions;
+                candidate.erase(candidate.begin() + i);
+                if (still_fails(candidate)) { functions = std::move(candidate); progress = true; }
+                else                        { ++i; }
+            }
+            for (auto& f : functions) {
+                for (auto i = std::size_t{0}; i < f.sites.size() && f.sites.size() > 1; ) {
+                    auto saved = f.sites;
+                    f.sites.erase(f.sites.begin() + i);
+                    if (still_fails(functions)) { progress = true; }
+                    else                        { f.sites = std::move(saved); ++i; }
+                }
+                for (auto i = 0; ; ) {
+                    auto saved = f.body;
+                    auto n     = i;
+                    if (!delete_stmt(f.body, n)) { break; }
+                    if (still_fails(functions)) { progress = true; }
+                    else                        { f.body = std::move(saved); ++i; }
+                }
+            }
+        }
+        return functions;
+    }
+};
+
+
+int main(int argc, char* argv[]) {
+    auto args   = std::vector<std::string>(argv+1, argv+argc);
+    auto check  = std::string{};
+    if (args.size() >= 2 && args[0] == "--reduce") {
+        check = args[1];
+        args.erase(args.begin(), args.begin()+2);
+    }
+    auto number = [&](std::size_t i, int otherwise) { return args.size() > i ? std::atoi(args[i].c_str()) : otherwise; };
+
+    auto seed      = number(0, 0);
+    auto functions = number(1, 20);
+    auto max_depth = number(2, 3);
+    auto max_stmts = number(3, 4);
+    if (args.empty() || args.size() > 4 || functions < 1 || max_depth < 1 || max_stmts < 1) {
+        std::cerr << "usage: " << argv[0]
+                  << " [--reduce <check command>] <seed> [functions] [max depth] [max statements per block]\n"
+                     "       functions, max depth and max statements must each be at least 1\n";
+        return EXIT_FAILURE;
+    }
+
+    auto origin = std::string{};
+    for (auto const& a : args) { origin += " " + a; }
+
+    auto gen = generator{ std::mt19937(seed), max_depth, max_stmts };
+    auto fs  = std::vector<function>{};
+    for (auto i = 0; i < functions; ++i) {
+        fs.push_back(gen.make_function(i, 4));
+    }
+
+    if (!check.empty()) {
+        origin = " --reduce" + origin;
+        auto path = "gen-fuzz-reduce-" + std::to_string(seed) + "-XXXXXX.cpp";
+        auto fd   = mkstemps(path.data(), 4);
+        if (fd < 0) {
+            std::perror("cannot create a file to reduce in");
+            return EXIT_FAILURE;
+        }
+        close(fd);
+        fs = reducer{ check, origin, path }.reduce(std::move(fs));
+        std::remove(path.c_str());
+    }
+    emit_program(std::cout, std::move(fs), origin);
+}
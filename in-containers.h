@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+
+//------------------------------------------------------------------------------
+//  "In" container wrappers, shared by test-in-containers.cpp and
+//  timing-in-containers.cpp
+//
+//  Today each container mutator that stores an element needs a const& and a
+//  && overload (the demo-in-2.cpp pattern). Written with "in", each mutator is
+//  one function whose last use moves if the argument is an rvalue. These are
+//  thin wrappers over the std containers so that the only difference in the
+//  history is the parameter passing.
+
+template<typename T>
+class in_vector {
+    std::vector<T> v;
+public:
+    void reserve(std::size_t n)                { v.reserve(n); }
+    void push_back(in T t)                     { v.push_back(t); }
+    void insert(std::size_t pos, in T t)       { v.insert(v.begin() + pos, t); }
+    void emplace_back(in auto... args)         { v.emplace_back(args...); }
+    auto size() const                          { return v.size(); }
+};
+
+template<typename T>
+class in_deque {
+    std::deque<T> d;
+public:
+    void push_back(in T t)                     { d.push_back(t); }
+    void push_front(in T t)                    { d.push_front(t); }
+    auto size() const                          { return d.size(); }
+};
+
+template<typename K, typename V, typename Hash = std::hash<K>, typename Eq = std::equal_to<K>>
+class in_hash_map {
+    std::unordered_map<K, V, Hash, Eq> m;
+public:
+    void reserve(std::size_t n)                { m.reserve(n); }
+    bool insert(in K key, in V value)          { return m.try_emplace(key, value).second; }
+    void insert_or_assign(in K key, in V value){ m.insert_or_assign(key, value); }
+    auto size() const                          { return m.size(); }
+};
@@ -0,0 +1,401 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <regex>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <sys/wait.h>
+
+
+//------------------------------------------------------------------------------
+//  Consolidated report across the test and demo programs: runs each program,
+//  collects its output, exit status and run time, picks out each compare()
+//  case's old and new histories, and writes it all to report.json plus a
+//  static report.html that shows old against new per case and per build.
+//
+//  This program is plain C++, build it with any compiler. Then pass it the
+//  built test/demo programs, grouped by build, e.g.:
+//
+//      report --build O0 o0/test-in o0/test-inout o0/demo-in-2 ...
+//             --build O2 o2/test-in o2/test-inout o2/demo-in-2 ...
+//
+//  The hst::tester programs (test-*) exit with 0 whether or not a case
+//  fails, so their output is parsed for per-case results and the summary's
+//  failure count. hst.h isn't part of this repo, so the patterns are
+//  options, with defaults that accept the usual shapes ("PASS name",
+//  "name: FAILED", "3 passed, 1 failed", ...):
+//
+//      --case-regex <regex>     one case result; group 1 is the pass/fail
+//                               word and group 2 the name, or the other way
+//                               round if group 1 isn't a pass/fail word
+//      --summary-regex <regex>  a failure count; group 1 is the number
+//
+//  A program fails if it exits nonzero, any of its cases fails, or its
+//  summary counts a failure. The compare() programs (demo-*) are also split
+//  into cases, each marked "same" or "different", with the number of copies
+//  (copy-ctor, copy-assign) and moves (move-ctor, move-assign) in the old and
+//  new histories.
+//
+//  Any output line of the form "<name>: <number> <unit>" is a metric, which
+//  is what the timing programs (timing-*) print, e.g.
+//  "rvalue, in: 12.5 ns/call". Metrics are listed per program and build.
+//
+//------------------------------------------------------------------------------
+
+//  Number of copy-ctor/copy-assign and move-ctor/move-assign events in a
+//  history
+struct event_counts {
+    int copies = 0, moves = 0;
+
+    explicit event_counts(std::string const& history) {
+        auto in   = std::istringstream(history);
+        auto word = std::string{};
+        while (in >> word) {
+            if (word == "copy-ctor" || word == "copy-assign") { ++copies; }
+            if (word == "move-ctor" || word == "move-assign") { ++moves; }
+        }
+    }
+};
+
+struct comparison {
+    std::string name, old_history, new_history;
+    bool same() const { return old_history == new_history; }
+    event_counts old_events() const { return event_counts(old_history); }
+    event_counts new_events() const { return event_counts(new_history); }
+};
+
+struct metric {
+    std::string name, unit;
+    double      value = 0;
+};
+
+struct test_case {
+    std::string name;
+    bool passed = false;
+};
+
+struct program_run {
+    std::string program, output;
+    int         status = 0;             // exit code, or 128+signal
+    double      milliseconds = 0;
+    int         summary_failures = 0;
+    std::vector<test_case>  cases;
+    std::vector<comparison> comparisons;
+    std::vector<metric>     metrics;
+
+    bool passed() const {
+        if (status != 0 || summary_failures != 0) { return false; }
+        for (auto const& c : cases) { if (!c.passed) { return false; } }
+        return true;
+    }
+};
+
+struct patterns {
+    std::regex case_result = std::regex(
+        R"(^\s*\[?(pass(?:ed)?|ok|fail(?:ed|ure)?)\]?[:\s-]+(.+?)\s*$|^\s*(.+?)[:\s.-]+\[?(pass(?:ed)?|ok|fail(?:ed|ure)?)\]?\s*$)",
+        std::regex::icase);
+    std::regex summary_failures = std::regex(
+        R"((\d+)\s+(?:tests?\s+|cases?\s+)?fail(?:ed|ures?|s)?\b)",
+        std::regex::icase);
+};
+
+struct build {
+    std::string name;
+    std::vector<program_run> runs;
+};
+
+//  Run a program and capture its stdout
+program_run run(std::string const& program) {
+    auto ret    = program_run{};
+    ret.program = program;
+    auto start  = std::chrono::steady_clock::now();
+    if (auto pipe = popen(program.c_str(), "r")) {
+        char buffer[4096];
+        while (auto n = std::fread(buffer, 1, sizeof buffer, pipe)) {
+            ret.output.append(buffer, n);
+        }
+        auto status = pclose(pipe);
+        ret.status = WIFEXITED(status)   ? WEXITSTATUS(status)
+                   : WIFSIGNALED(status) ? 128 + WTERMSIG(status)
+                   :                       -1;
+    } else {
+        ret.status = -1;
+    }
+    ret.milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    return ret;
+}
+
+//  compare() prints each case as: name, "  old: history", "  new: history"
+std::vector<comparison> parse_comparisons(std::string const& output) {
+    auto ret   = std::vector<comparison>{};
+    auto in    = std::istringstream(output);
+    auto line  = std::string{}, previous = std::string{};
+    while (std::getline(in, line)) {
+        if (line.starts_with("  old: ")) {
+            ret.push_back({ previous, line.substr(7), {} });
+        } else if (line.starts_with("  new: ") && !ret.empty()) {
+            ret.back().new_history = line.substr(7);
+        } else if (!line.empty()) {
+            previous = line;
+        }
+    }
+    return ret;
+}
+
+//  A metric line is "<name>: <number> <unit>"; see the header comment
+std::vector<metric> parse_metrics(std::string const& output) {
+    auto const line_re = std::regex(R"(^\s*(.*?)\s*:\s*(-?\d+(?:\.\d+)?(?:[eE][-+]?\d+)?)\s+(\S+)\s*$)");
+    auto ret  = std::vector<metric>{};
+    auto in   = std::istringstream(output);
+    auto line = std::string{};
+    while (std::getline(in, line)) {
+        auto m = std::smatch{};
+        if (std::regex_match(line, m, line_re)) {
+            ret.push_back({ m[1], m[3], std::stod(m[2]) });
+        }
+    }
+    return ret;
+}
+
+//  hst::tester prints case results and a summary; see the header comment
+void parse_tests(program_run& run, patterns const& pat) {
+    auto const is_pass = std::regex(R"(pass(?:ed)?|ok)", std::regex::icase);
+    auto in   = std::istringstream(run.output);
+    auto line = std::string{};
+    while (std::getline(in, line)) {
+        auto m = std::smatch{};
+        if (line.starts_with("  old: ") || line.starts_with("  new: ")) {
+            continue;
+        }
+        if (std::regex_search(line, m, pat.summary_failures)) {
+            run.summary_failures += std::stoi(m[1]);
+        }
+        else if (std::regex_match(line, m, pat.case_result)) {
+            //  The default pattern has two alternatives, word-then-name
+            //  (groups 1, 2) and name-then-word (groups 3, 4)
+            auto word = m[1].matched ? m[1].str() : m[4].str();
+            auto name = m[1].matched ? m[2].str() : m[3].str();
+            if (m.size() == 3 && !std::regex_match(word, std::regex(R"(pass(?:ed)?|ok|fail(?:ed|ure)?)", std::regex::icase))) {
+                std::swap(word, name);
+            }
+            run.cases.push_back({ name, std::regex_match(word, is_pass) });
+        }
+    }
+}
+
+std::string escape_json(std::string const& s) {
+    auto ret = std::string{};
+    for (auto c : s) {
+        switch (c) {
+        break;case '"':  ret += "\\\"";
+        break;case '\\': ret += "\\\\";
+        break;case '\n': ret += "\\n";
+        break;case '\t': ret += "\\t";
+        break;default:
+            if ((unsigned char)c < 0x20) { char buf[8]; std::snprintf(buf, sizeof buf, "\\u%04x", c); ret += buf; }
+            else                         { ret += c; }
+        }
+    }
+    return ret;
+}
+
+std::string escape_html(std::string const& s) {
+    auto ret = std::string{};
+    for (auto c : s) {
+        switch (c) {
+        break;case '<': ret += "&lt;";
+        break;case '>': ret += "&gt;";
+        break;case '&': ret += "&amp;";
+        break;case '"': ret += "&quot;";
+        break;default:  ret += c;
+        }
+    }
+    return ret;
+}
+
+void write_json(std::ostream& out, std::vector<build> const& builds) {
+    out << "{ \"builds\": [";
+    for (auto b = std::size_t{0}; b < builds.size(); ++b) {
+        out << (b ? "," : "") << "\n  { \"name\": \"" << escape_json(builds[b].name) << "\", \"runs\": [";
+        for (auto r = std::size_t{0}; r < builds[b].runs.size(); ++r) {
+            auto const& run = builds[b].runs[r];
+            out << (r ? "," : "") << "\n    { \"program\": \"" << escape_json(run.program) << "\""
+                << ", \"status\": " << run.status
+                << ", \"passed\": " << (run.passed() ? "true" : "false")
+                << ", \"summary_failures\": " << run.summary_failures
+                << ", \"milliseconds\": " << run.milliseconds
+                << ", \"output\": \"" << escape_json(run.output) << "\""
+                << ", \"cases\": [";
+            for (auto c = std::size_t{0}; c < run.cases.size(); ++c) {
+                out << (c ? "," : "") << "\n      { \"name\": \"" << escape_json(run.cases[c].name) << "\""
+                    << ", \"passed\": " << (run.cases[c].passed ? "true" : "false") << " }";
+            }
+            out << " ], \"comparisons\": [";
+            for (auto c = std::size_t{0}; c < run.comparisons.size(); ++c) {
+                auto const& cmp = run.comparisons[c];
+                out << (c ? "," : "") << "\n      { \"name\": \"" << escape_json(cmp.name) << "\""
+                    << ", \"old\": \"" << escape_json(cmp.old_history) << "\""
+                    << ", \"new\": \"" << escape_json(cmp.new_history) << "\""
+                    << ", \"same\": " << (cmp.same() ? "true" : "false")
+                    << ", \"old_copies\": " << cmp.old_events().copies
+                    << ", \"old_moves\": "  << cmp.old_events().moves
+                    << ", \"new_copies\": " << cmp.new_events().copies
+                    << ", \"new_moves\": "  << cmp.new_events().moves << " }";
+            }
+            out << " ], \"metrics\": [";
+            for (auto m = std::size_t{0}; m < run.metrics.size(); ++m) {
+                out << (m ? "," : "") << "\n      { \"name\": \"" << escape_json(run.metrics[m].name) << "\""
+                    << ", \"value\": " << run.metrics[m].value
+                    << ", \"unit\": \"" << escape_json(run.metrics[m].unit) << "\" }";
+            }
+            out << " ] }";
+        }
+        out << " ] }";
+    }
+    out << "\n] }\n";
+}
+
+void write_html(std::ostream& out, std::vector<build> const& builds) {
+    out << "<!DOCTYPE html>\n<html><head><meta charset=\"utf-8\"><title>708 prototype report</title>\n"
+           "<style>body{font-family:sans-serif} table{border-collapse:collapse} "
+           "td,th{border:1px solid #ccc;padding:2px 6px;vertical-align:top} "
+           ".same{background:#dfd} .different{background:#fdd} pre{font-size:small}</style>\n"
+           "</head><body>\n<h1>708 prototype report</h1>\n";
+
+    //  Summary: one row per program/case, one column per build
+    auto cases = std::map<std::string, std::map<std::string, comparison const*>>{};
+    for (auto const& b : builds) {
+        for (auto const& r : b.runs) {
+            for (auto const& c : r.comparisons) {
+                cases[r.program.substr(r.program.find_last_of('/')+1) + ": " + c.name][b.name] = &c;
+            }
+        }
+    }
+    out << "<h2>Old vs. new, per case and build</h2>\n<table><tr><th>case</th>";
+    for (auto const& b : builds) { out << "<th>" << escape_html(b.name) << "</th>"; }
+    out << "</tr>\n";
+    for (auto const& [name, per_build] : cases) {
+        out << "<tr><td>" << escape_html(name) << "</td>";
+        for (auto const& b : builds) {
+            auto c = per_build.find(b.name);
+            if (c == per_build.end()) { out << "<td></td>"; continue; }
+            auto const& cmp = *c->second;
+            out << "<td class=\"" << (cmp.same() ? "same\">same" : "different\">different")
+                << "<br>old: " << escape_html(cmp.old_history)
+                << " (" << cmp.old_events().copies << " copies, " << cmp.old_events().moves << " moves)"
+                << "<br>new: " << escape_html(cmp.new_history)
+                << " (" << cmp.new_events().copies << " copies, " << cmp.new_events().moves << " moves)</td>";
+        }
+        out << "</tr>\n";
+    }
+    out << "</table>\n";
+
+    //  Test results: one row per program/case, one column per build
+    auto results = std::map<std::string, std::map<std::string, bool>>{};
+    for (auto const& b : builds) {
+        for (auto const& r : b.runs) {
+            auto program = r.program.substr(r.program.find_last_of('/')+1);
+            results[program + " (program)"][b.name] = r.passed();
+            for (auto const& c : r.cases) {
+                results[program + ": " + c.name][b.name] = c.passed;
+            }
+        }
+    }
+    out << "<h2>Pass/fail, per case and build</h2>\n<table><tr><th>case</th>";
+    for (auto const& b : builds) { out << "<th>" << escape_html(b.name) << "</th>"; }
+    out << "</tr>\n";
+    for (auto const& [name, per_build] : results) {
+        out << "<tr><td>" << escape_html(name) << "</td>";
+        for (auto const& b : builds) {
+            auto c = per_build.find(b.name);
+            if (c == per_build.end()) { out << "<td></td>"; continue; }
+            out << "<td class=\"" << (c->second ? "same\">pass" : "different\">FAIL") << "</td>";
+        }
+        out << "</tr>\n";
+    }
+    out << "</table>\n";
+
+    //  Metrics: one row per program/metric, one column per build
+    auto metrics = std::map<std::string, std::map<std::string, metric const*>>{};
+    for (auto const& b : builds) {
+        for (auto const& r : b.runs) {
+            for (auto const& m : r.metrics) {
+                metrics[r.program.substr(r.program.find_last_of('/')+1) + ": " + m.name + " (" + m.unit + ")"][b.name] = &m;
+            }
+        }
+    }
+    if (!metrics.empty()) {
+        out << "<h2>Metrics, per build</h2>\n<table><tr><th>metric</th>";
+        for (auto const& b : builds) { out << "<th>" << escape_html(b.name) << "</th>"; }
+        out << "</tr>\n";
+        for (auto const& [name, per_build] : metrics) {
+            out << "<tr><td>" << escape_html(name) << "</td>";
+            for (auto const& b : builds) {
+                auto m = per_build.find(b.name);
+                if (m == per_build.end()) { out << "<td></td>"; continue; }
+                out << "<td>" << m->second->value << "</td>";
+            }
+            out << "</tr>\n";
+        }
+        out << "</table>\n";
+    }
+
+    //  Details: each program's status, time and full output
+    for (auto const& b : builds) {
+        out << "<h2>Build " << escape_html(b.name) << "</h2>\n"
+               "<table><tr><th>program</th><th>result</th><th>exit status</th><th>ms</th><th>output</th></tr>\n";
+        for (auto const& r : b.runs) {
+            out << "<tr><td>" << escape_html(r.program) << "</td>"
+                << "<td class=\"" << (r.passed() ? "same\">pass" : "different\">FAIL") << "</td>"
+                << "<td>" << r.status << "</td>"
+                << "<td>" << r.milliseconds << "</td>"
+                << "<td><pre>" << escape_html(r.output) << "</pre></td></tr>\n";
+        }
+        out << "</table>\n";
+    }
+    out << "</body></html>\n";
+}
+
+int main(int argc, char* argv[]) {
+    auto builds = std::vector<build>{};
+    auto pat    = patterns{};
+    for (auto i = 1; i < argc; ++i) {
+        auto arg = std::string(argv[i]);
+        if (arg == "--build" && i+1 < argc) {
+            builds.push_back({ argv[++i], {} });
+            continue;
+        }
+        if (arg == "--case-regex" && i+1 < argc) {
+            pat.case_result = std::regex(argv[++i], std::regex::icase);
+            continue;
+        }
+        if (arg == "--summary-regex" && i+1 < argc) {
+            pat.summary_failures = std::regex(argv[++i], std::regex::icase);
+            continue;
+        }
+        if (builds.empty()) { builds.push_back({ "default", {} }); }
+        auto r = run(arg);
+        r.comparisons = parse_comparisons(r.output);
+        r.metrics = parse_metrics(r.output);
+        parse_tests(r, pat);
+        std::cerr << arg << ": " << (r.passed() ? "pass" : "FAIL") << ", status " << r.status << ", "
+                  << r.cases.size() << " cases, " << r.comparisons.size() << " comparisons, "
+                  << r.metrics.size() << " metrics\n";
+        builds.back().runs.push_back(std::move(r));
+    }
+    if (builds.empty()) {
+        std::cerr << "usage: " << argv[0] << " [--case-regex <regex>] [--summary-regex <regex>]\n"
+                     "       [--build <name>] <program>... [--build <name> <program>...]...\n";
+        return EXIT_FAILURE;
+    }
+
+    auto json = std::ofstream("report.json");
+    write_json(json, builds);
+    auto html = std::ofstream("report.html");
+    write_html(html, builds);
+    std::cerr << "wrote report.json and report.html\n";
+}
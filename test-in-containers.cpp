@@ -0,0 +1,287 @@
+#include <https://raw.githubusercontent.com/hsutter/misc/master/hst.h>
+#include <iostream>
+#include "in-containers.h"
+
+
+//------------------------------------------------------------------------------
+//  "In" container sink tests, using the wrappers in in-containers.h, each
+//  against the std container called directly
+
+using String = hst::noisy<std::string>;
+
+//  So that String can be a hash map key
+struct string_hash  { auto operator()(const String& s) const { return std::hash<std::string>{}(s.t); } };
+struct string_equal { bool operator()(const String& a, const String& b) const { return a.t == b.t; } };
+
+using in_string_map  = in_hash_map<String, String, string_hash, string_equal>;
+using std_string_map = std::unordered_map<String, String, string_hash, string_equal>;
+
+
+//------------------------------------------------------------------------------
+//  Test cases: containers
+
+void container_tests() {
+    hst::tester test("in container cases");
+
+    //------------------------------------------------------------------------------
+    // vector: same history as std::vector's const&/&& overloads
+
+    test.run(
+        "vector push_back with nontrivial lvalue", 
+        []{
+            in_vector<String> v;  v.reserve(4);
+            String s;
+            v.push_back(s);
+        }, 
+        []{
+            std::vector<String> v;  v.reserve(4);
+            String s;
+            v.push_back(s);
+        });
+
+    test.run(
+        "vector push_back with nontrivial xvalue", 
+        []{
+            in_vector<String> v;  v.reserve(4);
+            String s;
+            v.push_back(move(s));
+        }, 
+        []{
+            std::vector<String> v;  v.reserve(4);
+            String s;
+            v.push_back(move(s));
+        });
+
+    test.run(
+        "vector push_back with nontrivial prvalue", 
+        []{
+            in_vector<String> v;  v.reserve(4);
+            v.push_back(String());
+        }, 
+        []{
+            std::vector<String> v;  v.reserve(4);
+            v.push_back(String());
+        });
+
+    test.run(
+        "vector push_back with nontrivial prvalue, no extra copies", 
+        []{
+            in_vector<String> v;  v.reserve(4);
+            v.push_back(String());
+        }, 
+        "default-ctor move-ctor dtor dtor ");
+
+    test.run(
+        "vector insert with nontrivial xvalue", 
+        []{
+            in_vector<String> v;  v.reserve(4);
+            String s;
+            v.insert(0, move(s));
+        }, 
+        []{
+            std::vector<String> v;  v.reserve(4);
+            String s;
+            v.insert(v.begin(), move(s));
+        });
+
+    test.run(
+        "vector emplace_back with nontrivial lvalue and prvalue", 
+        []{
+            in_vector<std::pair<String, String>> v;  v.reserve(4);
+            String s;
+            v.emplace_back(s, String());
+        }, 
+        []{
+            std::vector<std::pair<String, String>> v;  v.reserve(4);
+            String s;
+            v.emplace_back(s, String());
+        });
+
+    test.run(
+        "vector emplace_back with nontrivial xvalues", 
+        []{
+            in_vector<std::pair<String, String>> v;  v.reserve(4);
+            String s, s2;
+            v.emplace_back(move(s), move(s2));
+        }, 
+        []{
+            std::vector<std::pair<String, String>> v;  v.reserve(4);
+            String s, s2;
+            v.emplace_back(move(s), move(s2));
+        });
+
+    //------------------------------------------------------------------------------
+    // deque
+
+    test.run(
+        "deque push_back with nontrivial lvalue", 
+        []{
+            in_deque<String> d;
+            String s;
+            d.push_back(s);
+        }, 
+        []{
+            std::deque<String> d;
+            String s;
+            d.push_back(s);
+        });
+
+    test.run(
+        "deque push_front with nontrivial xvalue", 
+        []{
+            in_deque<String> d;
+            String s;
+            d.push_front(move(s));
+        }, 
+        []{
+            std::deque<String> d;
+            String s;
+            d.push_front(move(s));
+        });
+
+    test.run(
+        "deque push_back with nontrivial prvalue", 
+        []{
+            in_deque<String> d;
+            d.push_back(String());
+        }, 
+        []{
+            std::deque<String> d;
+            d.push_back(String());
+        });
+
+    //------------------------------------------------------------------------------
+    // hash map: one "in" function covers every key/value category combination
+
+    test.run(
+        "hash map insert with trivial key, nontrivial lvalue", 
+        []{
+            in_hash_map<int, String> m;
+            String s;
+            m.insert(1, s);
+        }, 
+        []{
+            std::unordered_map<int, String> m;
+            String s;
+            m.try_emplace(1, s);
+        });
+
+    test.run(
+        "hash map insert with trivial key, nontrivial xvalue", 
+        []{
+            in_hash_map<int, String> m;
+            String s;
+            m.insert(1, move(s));
+        }, 
+        []{
+            std::unordered_map<int, String> m;
+            String s;
+            m.try_emplace(1, move(s));
+        });
+
+    test.run(
+        "hash map insert with trivial key, nontrivial prvalue", 
+        []{
+            in_hash_map<int, String> m;
+            m.insert(1, String());
+        }, 
+        []{
+            std::unordered_map<int, String> m;
+            m.try_emplace(1, String());
+        });
+
+    test.run(
+        "hash map insert of existing key does not touch the value", 
+        []{
+            in_hash_map<int, String> m;
+            m.insert(1, String());
+            m.insert(1, String());
+        }, 
+        []{
+            std::unordered_map<int, String> m;
+            m.try_emplace(1, String());
+            m.try_emplace(1, String());
+        });
+
+    test.run(
+        "hash map insert_or_assign with nontrivial xvalue", 
+        []{
+            in_hash_map<int, String> m;
+            String s, s2;
+            m.insert_or_assign(1, move(s));
+            m.insert_or_assign(1, move(s2));
+        }, 
+        []{
+            std::unordered_map<int, String> m;
+            String s, s2;
+            m.insert_or_assign(1, move(s));
+            m.insert_or_assign(1, move(s2));
+        });
+
+    //------------------------------------------------------------------------------
+    // hash map with nontrivial keys
+
+    test.run(
+        "hash map insert with nontrivial lvalue key", 
+        []{
+            in_string_map m;
+            String k;
+            m.insert(k, String());
+        }, 
+        []{
+            std_string_map m;
+            String k;
+            m.try_emplace(k, String());
+        });
+
+    test.run(
+        "hash map insert with nontrivial xvalue key", 
+        []{
+            in_string_map m;
+            String k, v;
+            m.insert(move(k), v);
+        }, 
+        []{
+            std_string_map m;
+            String k, v;
+            m.try_emplace(move(k), v);
+        });
+
+    test.run(
+        "hash map insert with nontrivial prvalue key and value", 
+        []{
+            in_string_map m;
+            m.insert(String(), String());
+        }, 
+        []{
+            std_string_map m;
+            m.try_emplace(String(), String());
+        });
+
+    test.run(
+        "hash map insert of existing nontrivial xvalue key does not move it", 
+        []{
+            in_string_map m;
+            String k;  k.t = "key ";
+            m.insert(k, String());
+            m.insert(move(k), String());
+            hst::history += k.t;
+        }, 
+        []{
+            std_string_map m;
+            String k;  k.t = "key ";
+            m.try_emplace(k, String());
+            m.try_emplace(move(k), String());
+            hst::history += k.t;
+        });
+
+    std::cout << test.summary();
+
+}
+
+//------------------------------------------------------------------------------
+//  One main to run them all
+
+int main() {
+    container_tests();
+}
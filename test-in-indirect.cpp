@@ -0,0 +1,295 @@
+#include <https://raw.githubusercontent.com/hsutter/misc/master/hst.h>
+#include <functional>
+#include <iostream>
+
+
+//------------------------------------------------------------------------------
+//  "In" and "move" through indirect calls: virtual functions, function
+//  pointers, and std::function
+//
+//  An indirect call has a single entry point, so it can't pick a body per
+//  lvalue/rvalue argument the way a direct call can -- the rvalue-ness has to
+//  travel with the argument instead. These tests check that an rvalue caller
+//  still gets the move through the indirect call.
+
+//  Helper, just to try a different kind of copy than initializing/assigning a
+//  local variable (in case the difference matters).
+template<typename T>
+void copy_from(T) { }
+
+using String = hst::noisy<std::string>;
+
+//- Virtual functions ----------------------------------------------------------
+
+struct new_base {
+    virtual void sink(in String t) = 0;
+    virtual void consume(move String t) = 0;
+    virtual ~new_base() = default;
+};
+
+struct new_derived : new_base {
+    void sink(in String t) override {
+        copy_from(t);       // should be a move if arg is an rvalue
+    }
+    void consume(move String t) override {
+        copy_from(t);       // always a move
+    }
+};
+
+//  Today's way, to get the same behavior: an overload pair per parameter
+struct old_base {
+    virtual void sink(const String& t) = 0;
+    virtual void sink(String&& t) = 0;
+    virtual void consume(String&& t) = 0;
+    virtual ~old_base() = default;
+};
+
+struct old_derived : old_base {
+    void sink(const String& t) override {
+        copy_from(t);
+    }
+    void sink(String&& t) override {
+        copy_from(std::move(t));
+    }
+    void consume(String&& t) override {
+        copy_from(std::move(t));
+    }
+};
+
+//  Today's other way: the by-value sink idiom, one function but an extra move
+struct byvalue_base {
+    virtual void sink(String t) = 0;
+    virtual ~byvalue_base() = default;
+};
+
+struct byvalue_derived : byvalue_base {
+    void sink(String t) override {
+        copy_from(std::move(t));
+    }
+};
+
+//- Function pointers and std::function ----------------------------------------
+
+void string_in_copy(in String t) {
+    copy_from(t);           // should be a move if arg is an rvalue
+}
+
+void string_move_copy(move String t) {
+    copy_from(t);           // always a move
+}
+
+void traditional_in(const String& t) {
+    copy_from(t);
+}
+
+void traditional_in(String&& t) {
+    copy_from(std::move(t));
+}
+
+
+//------------------------------------------------------------------------------
+//  Test cases: indirect calls
+
+void indirect_tests() {
+    hst::tester test("in parameter indirect call cases");
+
+    //------------------------------------------------------------------------------
+    // Virtual "in": should behave like the const&/&& virtual overload pair
+
+    test.run(
+        "virtual in with nontrivial lvalue", 
+        []{
+            new_derived d;  new_base& b = d;
+            String s;
+            b.sink(s);
+        }, 
+        []{
+            old_derived d;  old_base& b = d;
+            String s;
+            b.sink(s);
+        });
+
+    test.run(
+        "virtual in with nontrivial xvalue", 
+        []{
+            new_derived d;  new_base& b = d;
+            String s;
+            b.sink(move(s));
+        }, 
+        []{
+            old_derived d;  old_base& b = d;
+            String s;
+            b.sink(move(s));
+        });
+
+    test.run(
+        "virtual in with nontrivial prvalue", 
+        []{
+            new_derived d;  new_base& b = d;
+            b.sink(String());
+        }, 
+        []{
+            old_derived d;  old_base& b = d;
+            b.sink(String());
+        });
+
+    //------------------------------------------------------------------------------
+    // Virtual "in" vs. by-value sink: "in" saves the extra move for rvalues
+
+    test.run(
+        "virtual in with nontrivial prvalue, vs. by-value sink", 
+        []{
+            new_derived d;  new_base& b = d;
+            b.sink(String());
+        }, 
+        "default-ctor move-ctor dtor dtor ");
+
+    test.run(
+        "virtual by-value sink with nontrivial prvalue", 
+        []{
+            byvalue_derived d;  byvalue_base& b = d;
+            b.sink(String());
+        }, 
+        "default-ctor move-ctor dtor dtor ");   // prvalue initializes the param directly
+
+    test.run(
+        "virtual by-value sink with nontrivial xvalue", 
+        []{
+            byvalue_derived d;  byvalue_base& b = d;
+            String s;
+            b.sink(move(s));
+        }, 
+        "default-ctor move-ctor move-ctor dtor dtor dtor ");    // the extra move
+
+    test.run(
+        "virtual in with nontrivial xvalue, vs. by-value sink", 
+        []{
+            new_derived d;  new_base& b = d;
+            String s;
+            b.sink(move(s));
+        }, 
+        "default-ctor move-ctor dtor dtor ");
+
+    //------------------------------------------------------------------------------
+    // Virtual "move"
+
+    test.run(
+        "virtual move with nontrivial xvalue", 
+        []{
+            new_derived d;  new_base& b = d;
+            String s;
+            b.consume(move(s));
+        }, 
+        []{
+            old_derived d;  old_base& b = d;
+            String s;
+            b.consume(move(s));
+        });
+
+    test.run(
+        "virtual move with nontrivial prvalue", 
+        []{
+            new_derived d;  new_base& b = d;
+            b.consume(String());
+        }, 
+        []{
+            old_derived d;  old_base& b = d;
+            b.consume(String());
+        });
+
+    //------------------------------------------------------------------------------
+    // Function pointers: one pointer type, same behavior as a direct call
+
+    test.run(
+        "function pointer in with nontrivial lvalue", 
+        []{
+            void (*pf)(in String) = &string_in_copy;
+            String s;
+            pf(s);
+        }, 
+        []{
+            String s;
+            traditional_in(s);
+        });
+
+    test.run(
+        "function pointer in with nontrivial xvalue", 
+        []{
+            void (*pf)(in String) = &string_in_copy;
+            String s;
+            pf(move(s));
+        }, 
+        []{
+            String s;
+            traditional_in(move(s));
+        });
+
+    test.run(
+        "function pointer in with nontrivial prvalue", 
+        []{
+            void (*pf)(in String) = &string_in_copy;
+            pf(String());
+        }, 
+        []{
+            traditional_in(String());
+        });
+
+    test.run(
+        "function pointer move with nontrivial xvalue", 
+        []{
+            void (*pf)(move String) = &string_move_copy;
+            String s;
+            pf(move(s));
+        }, 
+        []{
+            String s;
+            traditional_in(move(s));
+        });
+
+    //------------------------------------------------------------------------------
+    // std::function: same again, through type erasure
+
+    test.run(
+        "std::function in with nontrivial lvalue", 
+        []{
+            std::function<void(in String)> f = string_in_copy;
+            String s;
+            f(s);
+        }, 
+        []{
+            String s;
+            traditional_in(s);
+        });
+
+    test.run(
+        "std::function in with nontrivial xvalue", 
+        []{
+            std::function<void(in String)> f = string_in_copy;
+            String s;
+            f(move(s));
+        }, 
+        []{
+            String s;
+            traditional_in(move(s));
+        });
+
+    test.run(
+        "std::function in with nontrivial prvalue", 
+        []{
+            std::function<void(in String)> f = string_in_copy;
+            f(String());
+        }, 
+        []{
+            traditional_in(String());
+        });
+
+    std::cout << test.summary();
+
+}
+
+//------------------------------------------------------------------------------
+//  One main to run them all
+
+int main() {
+    indirect_tests();
+}
@@ -0,0 +1,188 @@
+#include <https://raw.githubusercontent.com/hsutter/misc/master/hst.h>
+#include <iostream>
+#include <vector>
+
+
+//------------------------------------------------------------------------------
+//  "In" exception-safety tests
+//
+//  A last-use move only pays off in generic code if the moving operation is
+//  noexcept: std::vector relocates with moves only if move_if_noexcept says
+//  so. When the only potentially-throwing operation in a function is the
+//  copy of an "in" parameter, and an rvalue argument turns that copy into a
+//  noexcept move, the call should be noexcept too.
+
+using String = hst::noisy<std::string>;
+
+//  A noisy type whose copy may throw, but whose move does not (and whose
+//  default construction doesn't count, so that a prvalue argument doesn't
+//  make the call potentially-throwing by itself)
+struct Throwing {
+    String s;
+    Throwing() noexcept = default;
+    Throwing(const Throwing& that) noexcept(false) : s(that.s) { }
+    Throwing(Throwing&&) noexcept = default;
+    Throwing& operator=(const Throwing& that) noexcept(false) { s = that.s; return *this; }
+    Throwing& operator=(Throwing&&) noexcept = default;
+};
+
+//  Only throwing operation is the copy, which becomes a move if arg is an rvalue
+void throwing_in_copy(in Throwing t) {
+    Throwing local = t;
+}
+
+//  Always copies, so always may throw
+void throwing_in_copy_first(in Throwing t) {
+    Throwing local = t;     // not the last use, so always a copy
+    (void)t;
+}
+
+//  Record whether a call expression is noexcept
+#define RECORD_NOEXCEPT(expr) (hst::history += noexcept(expr) ? "noexcept " : "may-throw ")
+
+//- Types whose constructors take "in" parameters ------------------------------
+
+//  Copying and moving a widget both delegate to its "in" constructor, so
+//  whether std::vector relocates by move (via move_if_noexcept) depends on
+//  that constructor's deduced noexcept for an rvalue argument
+struct new_widget {
+    Throwing t;
+    new_widget(in Throwing t_) : t(t_) { }      // a move if arg is an rvalue
+    new_widget(const new_widget& that) : new_widget(that.t) { }
+    new_widget(new_widget&& that) noexcept(noexcept(new_widget(std::move(that.t))))
+        : new_widget(std::move(that.t)) { }
+};
+
+//  Today's way, where the noexcept on the && constructor is written by hand
+struct old_widget {
+    Throwing t;
+    old_widget(const Throwing& t_) : t(t_) { }
+    old_widget(Throwing&& t_) noexcept : t(std::move(t_)) { }
+    old_widget(const old_widget& that) : old_widget(that.t) { }
+    old_widget(old_widget&& that) noexcept(noexcept(old_widget(std::move(that.t))))
+        : old_widget(std::move(that.t)) { }
+};
+
+//  Record whether a type trait holds
+#define RECORD_TRAIT(...) (hst::history += (__VA_ARGS__) ? "true " : "false ")
+
+
+//------------------------------------------------------------------------------
+//  Test cases: noexcept
+
+void noexcept_tests() {
+    hst::tester test("in noexcept cases");
+
+    //------------------------------------------------------------------------------
+    // Deduced noexcept follows the argument's value category
+
+    test.run(
+        "in_copy with throwing-copy lvalue", 
+        []{
+            Throwing t;
+            RECORD_NOEXCEPT(throwing_in_copy(t));
+        }, 
+        "default-ctor may-throw dtor ");
+
+    test.run(
+        "in_copy with throwing-copy xvalue", 
+        []{
+            Throwing t;
+            RECORD_NOEXCEPT(throwing_in_copy(std::move(t)));
+        }, 
+        "default-ctor noexcept dtor ");
+
+    test.run(
+        "in_copy with throwing-copy prvalue", 
+        []{
+            RECORD_NOEXCEPT(throwing_in_copy(Throwing()));
+        }, 
+        "noexcept ");   // unevaluated, so no history from the prvalue
+
+    test.run(
+        "in_copy_first with throwing-copy xvalue", 
+        []{
+            Throwing t;
+            RECORD_NOEXCEPT(throwing_in_copy_first(std::move(t)));
+        }, 
+        "default-ctor may-throw dtor ");
+
+    test.run(
+        "in_copy with throwing-copy xvalue, moves", 
+        []{
+            Throwing t;
+            throwing_in_copy(std::move(t));
+        }, 
+        "default-ctor move-ctor dtor dtor ");
+
+    //------------------------------------------------------------------------------
+    // "in" constructors: same noexcept-ness and same vector growth as the
+    // traditional const&/&& constructor pair
+
+    test.run(
+        "in constructor with throwing-copy xvalue is noexcept", 
+        []{
+            Throwing t;
+            RECORD_NOEXCEPT(new_widget(std::move(t)));
+            RECORD_NOEXCEPT(old_widget(std::move(t)));
+        }, 
+        "default-ctor noexcept noexcept dtor ");
+
+    test.run(
+        "in constructor noexcept-ness matches traditional constructor pair", 
+        []{
+            RECORD_TRAIT(std::is_nothrow_constructible_v<new_widget, Throwing&&>);
+            RECORD_TRAIT(std::is_nothrow_constructible_v<new_widget, Throwing&>);
+            RECORD_TRAIT(std::is_nothrow_move_constructible_v<new_widget>);
+        }, 
+        []{
+            RECORD_TRAIT(std::is_nothrow_constructible_v<old_widget, Throwing&&>);
+            RECORD_TRAIT(std::is_nothrow_constructible_v<old_widget, Throwing&>);
+            RECORD_TRAIT(std::is_nothrow_move_constructible_v<old_widget>);
+        });
+
+    test.run(
+        "in constructor noexcept-ness", 
+        []{
+            RECORD_TRAIT(std::is_nothrow_constructible_v<new_widget, Throwing&&>);
+            RECORD_TRAIT(std::is_nothrow_constructible_v<new_widget, Throwing&>);
+            RECORD_TRAIT(std::is_nothrow_move_constructible_v<new_widget>);
+        }, 
+        "true false true ");
+
+    test.run(
+        "vector growth of type with in constructor", 
+        []{
+            std::vector<new_widget> v;
+            v.reserve(1);
+            v.emplace_back(Throwing());
+            v.emplace_back(Throwing());     // reallocates
+        }, 
+        []{
+            std::vector<old_widget> v;
+            v.reserve(1);
+            v.emplace_back(Throwing());
+            v.emplace_back(Throwing());     // reallocates
+        });
+
+    test.run(
+        "vector growth of type with in constructor relocates by move", 
+        []{
+            std::vector<new_widget> v;
+            v.reserve(1);
+            v.emplace_back(Throwing());
+            hst::history = {};
+            v.reserve(2);                   // reallocates
+        }, 
+        "move-ctor dtor dtor ");   // a copy-ctor here would mean the "in" constructor isn't noexcept
+
+    std::cout << test.summary();
+
+}
+
+//------------------------------------------------------------------------------
+//  One main to run them all
+
+int main() {
+    noexcept_tests();
+}
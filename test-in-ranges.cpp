@@ -0,0 +1,235 @@
+#include <https://raw.githubusercontent.com/hsutter/misc/master/hst.h>
+#include <iostream>
+#include <span>
+#include <vector>
+
+
+//------------------------------------------------------------------------------
+//  "In" range tests
+//
+//  An "in" container parameter behaves like any other "in" parameter: an
+//  lvalue argument is passed by pointer (a view, no element copies), and an
+//  rvalue argument's last use is a move, so a whole batch can be handed down
+//  a pipeline and stored at the end without copying any element. A loop over
+//  the batch that is its last use moves each element out one at a time. For
+//  read-only subranges and arrays, "in std::span" gives a view without
+//  copying any element; the span itself is 16 bytes, so by this repo's
+//  should_pass_by_value_v rule (trivially copyable and smaller than 8 bytes)
+//  it is passed by pointer like any other larger "in" parameter.
+
+//  Helper, just to try a different kind of copy than initializing/assigning a
+//  local variable (in case the difference matters).
+template<typename T>
+void copy_from(T) { }
+
+using String = hst::noisy<std::string>;
+using Batch  = std::vector<String>;
+
+//- Pipeline -------------------------------------------------------------------
+
+//  Each stage reads the batch, then hands it on as its last use
+void stage4(in Batch b, inout Batch out) {
+    out = b;            // should be a move if arg is an rvalue
+}
+void stage3(in Batch b, inout Batch out) { (void)b.size(); stage4(b, out); }
+void stage2(in Batch b, inout Batch out) { (void)b.size(); stage3(b, out); }
+void stage1(in Batch b, inout Batch out) { (void)b.size(); stage2(b, out); }
+
+//  Today's way: a const&/&& pair per stage
+void old_stage4(const Batch& b, Batch& out) { out = b; }
+void old_stage4(Batch&& b,      Batch& out) { out = std::move(b); }
+void old_stage3(const Batch& b, Batch& out) { (void)b.size(); old_stage4(b, out); }
+void old_stage3(Batch&& b,      Batch& out) { (void)b.size(); old_stage4(std::move(b), out); }
+void old_stage2(const Batch& b, Batch& out) { (void)b.size(); old_stage3(b, out); }
+void old_stage2(Batch&& b,      Batch& out) { (void)b.size(); old_stage3(std::move(b), out); }
+void old_stage1(const Batch& b, Batch& out) { (void)b.size(); old_stage2(b, out); }
+void old_stage1(Batch&& b,      Batch& out) { (void)b.size(); old_stage2(std::move(b), out); }
+
+//  Elementwise sink. The range-for rule: the range expression "b" is a use
+//  of b like any other, here its last use since nothing after the loop uses
+//  b. The loop variable "e" names a different element of b on each
+//  iteration, so when the range is such a last use, e's last use within one
+//  iteration's body is a last use of that element: push_back(e) moves each
+//  element out if arg is an rvalue. A use of b itself inside the body is
+//  never a last use, since the next iteration can use it again.
+void stage_elements(in Batch b, inout Batch out) {
+    for (auto&& e : b) { out.push_back(e); }
+}
+
+void old_stage_elements(const Batch& b, Batch& out) { for (auto& e : b) { out.push_back(e); } }
+void old_stage_elements(Batch&& b,      Batch& out) { for (auto& e : b) { out.push_back(std::move(e)); } }
+
+//- Read-only views ------------------------------------------------------------
+
+void span_in(in std::span<const String> s, std::span<const String>* p) {
+    hst::history += &s==p ? "pass-by-pointer " : "pass-by-copy ";
+}
+
+void read_all(in std::span<const String> s, std::span<const String>* p) {
+    hst::history += s.data()==p->data() && s.size()==p->size() ? "same-view " : "different-view ";
+    for (auto& e : s) { copy_from(e); }     // each element is a copy
+}
+
+void traditional_read_all(const Batch& b, const Batch* p) {
+    hst::history += &b==p ? "same-view " : "different-view ";
+    for (auto& e : b) { copy_from(e); }
+}
+
+
+//------------------------------------------------------------------------------
+//  Test cases: ranges
+
+void range_tests() {
+    hst::tester test("in range cases");
+
+    //------------------------------------------------------------------------------
+    // Pipeline: lvalue batch is copied once, at the end; rvalue batch never
+
+    test.run(
+        "pipeline with batch lvalue", 
+        []{
+            Batch b(2), out;
+            stage1(b, out);
+        }, 
+        []{
+            Batch b(2), out;
+            old_stage1(b, out);
+        });
+
+    test.run(
+        "pipeline with batch lvalue, elements copied once", 
+        []{
+            Batch b(2), out;
+            stage1(b, out);
+        }, 
+        "default-ctor default-ctor copy-ctor copy-ctor dtor dtor dtor dtor ");
+
+    test.run(
+        "pipeline with batch xvalue", 
+        []{
+            Batch b(2), out;
+            stage1(move(b), out);
+        }, 
+        []{
+            Batch b(2), out;
+            old_stage1(move(b), out);
+        });
+
+    test.run(
+        "pipeline with batch xvalue, no element copies or moves", 
+        []{
+            Batch b(2), out;
+            stage1(move(b), out);
+        }, 
+        "default-ctor default-ctor dtor dtor ");
+
+    test.run(
+        "pipeline with batch prvalue", 
+        []{
+            Batch out;
+            stage1(Batch(2), out);
+        }, 
+        []{
+            Batch out;
+            old_stage1(Batch(2), out);
+        });
+
+    //------------------------------------------------------------------------------
+    // Elementwise sink: each element copied for an lvalue, moved for an rvalue
+
+    test.run(
+        "elementwise sink with batch lvalue", 
+        []{
+            Batch b(2), out;  out.reserve(2);
+            stage_elements(b, out);
+        }, 
+        "default-ctor default-ctor copy-ctor copy-ctor dtor dtor dtor dtor ");
+
+    test.run(
+        "elementwise sink with batch xvalue", 
+        []{
+            Batch b(2), out;  out.reserve(2);
+            stage_elements(move(b), out);
+        }, 
+        "default-ctor default-ctor move-ctor move-ctor dtor dtor dtor dtor ");
+
+    test.run(
+        "elementwise sink with batch prvalue", 
+        []{
+            Batch out;  out.reserve(2);
+            stage_elements(Batch(2), out);
+        }, 
+        "default-ctor default-ctor move-ctor move-ctor dtor dtor dtor dtor ");
+
+    test.run(
+        "elementwise sink equivalence with traditional, batch xvalue", 
+        []{
+            Batch b(2), out;  out.reserve(2);
+            stage_elements(move(b), out);
+        }, 
+        []{
+            Batch b(2), out;  out.reserve(2);
+            old_stage_elements(move(b), out);
+        });
+
+    //------------------------------------------------------------------------------
+    // Views: arrays and subranges without copying the container
+
+    test.run(
+        "in with span lvalue", 
+        []{
+            Batch b(2);
+            auto s = std::span<const String>(b);
+            span_in(s, &s);
+        }, 
+        "default-ctor default-ctor pass-by-pointer dtor dtor ");
+
+    test.run(
+        "span over whole vector", 
+        []{
+            Batch b(2);
+            auto s = std::span<const String>(b);
+            read_all(b, &s);
+        }, 
+        "default-ctor default-ctor same-view copy-ctor dtor copy-ctor dtor dtor dtor ");
+
+    test.run(
+        "span over subrange", 
+        []{
+            Batch b(3);
+            auto s = std::span<const String>(b).subspan(1);
+            read_all(s, &s);
+        }, 
+        "default-ctor default-ctor default-ctor same-view copy-ctor dtor copy-ctor dtor dtor dtor dtor ");
+
+    test.run(
+        "span over array", 
+        []{
+            String a[2];
+            auto s = std::span<const String>(a);
+            read_all(a, &s);
+        }, 
+        "default-ctor default-ctor same-view copy-ctor dtor copy-ctor dtor dtor dtor ");
+
+    test.run(
+        "span equivalence with traditional const vector&", 
+        []{
+            Batch b(2);
+            auto s = std::span<const String>(b);
+            read_all(b, &s);
+        }, 
+        []{
+            Batch b(2);
+            traditional_read_all(b, &b);
+        });
+
+    std::cout << test.summary();
+
+}
+
+//------------------------------------------------------------------------------
+//  One main to run them all
+
+int main() {
+    range_tests();
+}
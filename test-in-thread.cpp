@@ -0,0 +1,133 @@
+#include <https://raw.githubusercontent.com/hsutter/misc/master/hst.h>
+#include <functional>
+#include <iostream>
+#include <thread>
+
+
+//------------------------------------------------------------------------------
+//  "In" and "move" parameters as thread entry points
+//
+//  A thread can outlive the caller's full-expression, so the new thread must
+//  never see the caller's argument by pointer. std::thread/std::jthread
+//  already guarantee that: each argument is decay-copied into storage owned
+//  by the new thread, and the entry point is invoked with that storage as an
+//  rvalue. So an "in" entry point's by-pointer lowering points into
+//  thread-owned storage, and its last use is a move -- lvalue arguments copy
+//  exactly once (into the thread), and rvalue arguments copy zero times.
+//  std::ref opts back into sharing the caller's object, and the lifetime
+//  hazard that goes with it, exactly as today.
+//
+//  Each test joins before reading the history, so the history is only ever
+//  appended to by one thread at a time.
+
+using String = hst::noisy<std::string>;
+
+void worker_in(in String s) {
+    String local = s;       // should be a move if arg is an rvalue
+}
+
+void worker_move(move String s) {
+    String local = s;       // always a move
+}
+
+//  Today's by-value sink idiom, for comparison
+void worker_byvalue(String s) {
+    String local = std::move(s);
+}
+
+
+//------------------------------------------------------------------------------
+//  Test cases: threads
+
+void thread_tests() {
+    hst::tester test("in thread launch cases");
+
+    //------------------------------------------------------------------------------
+    // "in" entry point: one copy for an lvalue, none for an rvalue
+
+    test.run(
+        "jthread in with nontrivial lvalue", 
+        []{
+            String s;
+            { std::jthread t(worker_in, s); }
+        }, 
+        "default-ctor copy-ctor move-ctor dtor dtor dtor ");
+
+    test.run(
+        "jthread in with nontrivial xvalue", 
+        []{
+            String s;
+            { std::jthread t(worker_in, move(s)); }
+        }, 
+        "default-ctor move-ctor move-ctor dtor dtor dtor ");
+
+    test.run(
+        "jthread in with nontrivial prvalue", 
+        []{
+            //  The thread only ever sees its own decay-copy; joining within
+            //  the full-expression just records the temporary's dtor last
+            std::jthread(worker_in, String()).join();
+        }, 
+        "default-ctor move-ctor move-ctor dtor dtor dtor ");
+
+    test.run(
+        "thread in with nontrivial xvalue", 
+        []{
+            String s;
+            std::thread t(worker_in, move(s));
+            t.join();
+        }, 
+        "default-ctor move-ctor move-ctor dtor dtor dtor ");
+
+    //------------------------------------------------------------------------------
+    // std::ref shares the caller's object: no copy into the thread, and the
+    // argument is an lvalue, so the last use is a copy
+
+    test.run(
+        "jthread in with std::ref", 
+        []{
+            String s;
+            { std::jthread t(worker_in, std::ref(s)); }
+        }, 
+        "default-ctor copy-ctor dtor dtor ");
+
+    //------------------------------------------------------------------------------
+    // "move" entry point: rvalues only
+
+    test.run(
+        "jthread move with nontrivial xvalue", 
+        []{
+            String s;
+            { std::jthread t(worker_move, move(s)); }
+        }, 
+        "default-ctor move-ctor move-ctor dtor dtor dtor ");
+
+    //------------------------------------------------------------------------------
+    // Compare with the by-value sink, which costs an extra move either way
+
+    test.run(
+        "jthread by-value sink with nontrivial lvalue", 
+        []{
+            String s;
+            { std::jthread t(worker_byvalue, s); }
+        }, 
+        "default-ctor copy-ctor move-ctor move-ctor dtor dtor dtor dtor ");
+
+    test.run(
+        "jthread by-value sink with nontrivial xvalue", 
+        []{
+            String s;
+            { std::jthread t(worker_byvalue, move(s)); }
+        }, 
+        "default-ctor move-ctor move-ctor move-ctor dtor dtor dtor dtor ");
+
+    std::cout << test.summary();
+
+}
+
+//------------------------------------------------------------------------------
+//  One main to run them all
+
+int main() {
+    thread_tests();
+}
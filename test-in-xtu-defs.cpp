@@ -0,0 +1,54 @@
+#include "test-in-xtu.h"
+
+
+//------------------------------------------------------------------------------
+//  Definitions for test-in-xtu.cpp -- same bodies as in test-in.cpp, but
+//  compiled separately from their callers
+
+//  Helper, just to try a different kind of copy than initializing/assigning a
+//  local variable (in case the difference matters).
+template<typename T>
+void copy_from(T) { }
+
+//- Built-in type --------------------------------------------------------------
+
+void int_in(in int t, int* p) {
+    hst::history += &t==p ? "pass-by-pointer " : "pass-by-copy ";
+}
+
+//- Nontrivial concrete type ---------------------------------------------------
+
+void string_in(in String t) {
+    (void)t;
+}
+
+void string_in_copy(in String t) {
+    String local;
+    local = t;    // should be a move if arg is an rvalue
+}
+
+void string_in_copy_last(in String t) {
+    if (rand()%2) {
+        String local;
+        local = t;   // should always be a copy
+    } else {
+        String local2;
+        local2 = t;   // should always be a copy
+    }
+    String last_use;
+    last_use = t;       // should be a move assignment if arg is an rvalue
+}
+
+//- Comparison with traditional ------------------------------------------------
+
+void traditional_in(const String& t) {
+    copy_from(t);
+}
+
+void traditional_in(String&& t) {
+    copy_from(std::move(t));
+}
+
+void new_in(in String t) {
+    copy_from(t);
+}
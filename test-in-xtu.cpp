@@ -0,0 +1,147 @@
+#include "test-in-xtu.h"
+#include <iostream>
+
+
+//------------------------------------------------------------------------------
+//  Test cases: in, where every callee is defined in another TU
+//
+//  The expected histories are the same as for the same-TU cases in
+//  test-in.cpp, because the callee's "is the argument an rvalue" information
+//  has to survive separate compilation for the last use to still be a move
+
+void in_xtu_tests() {
+    hst::tester test("in parameter cross-TU cases");
+
+    //------------------------------------------------------------------------------
+    // Pass trivial lvalue: Should pass by copy
+
+    test.run(
+        "in with trivial lvalue", 
+        []{
+            int i = 0;
+            int_in(i, &i);
+        }, 
+        "pass-by-copy ");
+
+    //------------------------------------------------------------------------------
+    // Pass nontrivial lvalue: Should pass by ptr/ref, then copy inside string_in_copy*
+
+    test.run(
+        "in with nontrivial lvalue", 
+        []{
+            String s;
+            string_in(s);
+        }, 
+        "default-ctor dtor ");
+
+    test.run(
+        "in_copy with nontrivial lvalue", 
+        []{
+            String s;
+            string_in_copy(s);
+        }, 
+        "default-ctor default-ctor copy-assign dtor dtor ");
+
+    test.run(
+        "in_copy_last with nontrivial lvalue", 
+        []{
+            String s;
+            string_in_copy_last(s);
+        }, 
+        "default-ctor default-ctor copy-assign dtor default-ctor copy-assign dtor dtor ");
+
+    //------------------------------------------------------------------------------
+    // Pass nontrivial xvalue: Should pass by ptr/ref, then move inside string_in_copy*
+
+    test.run(
+        "in with nontrivial xvalue", 
+        []{ 
+            String s;
+            string_in(move(s));
+        }, 
+        "default-ctor dtor ");
+
+    test.run(
+        "in_copy with nontrivial xvalue", 
+        []{ 
+            String s;
+            string_in_copy(move(s));
+        }, 
+        "default-ctor default-ctor move-assign dtor dtor ");
+
+    test.run(
+        "in_copy_last with nontrivial xvalue", 
+        []{ 
+            String s;
+            string_in_copy_last(move(s));
+        }, 
+        "default-ctor default-ctor copy-assign dtor default-ctor move-assign dtor dtor ");
+
+    //------------------------------------------------------------------------------
+    // Pass nontrivial prvalue: Should pass by ptr/ref, then move inside string_in_copy*
+
+    test.run(
+        "in with nontrivial prvalue", 
+        []{ 
+            string_in(String());
+        }, 
+        "default-ctor dtor ");
+
+    test.run(
+        "in_copy with nontrivial prvalue", 
+        []{ 
+            string_in_copy(String());
+        }, 
+        "default-ctor default-ctor move-assign dtor dtor ");
+
+    test.run(
+        "in_copy_last with nontrivial prvalue", 
+        []{ 
+            string_in_copy_last(String());
+        }, 
+        "default-ctor default-ctor copy-assign dtor default-ctor move-assign dtor dtor ");
+
+    //------------------------------------------------------------------------------
+    // Compare traditional_in and new_in, both defined in the other TU
+
+    test.run(
+        "in equivalence with traditional, nontrivial lvalue", 
+        []{ 
+            String s;
+            new_in(s);
+        }, 
+        []{ 
+            String s;
+            traditional_in(s);
+        });
+
+    test.run(
+        "in equivalence with traditional, nontrivial xvalue", 
+        []{ 
+            String s;
+            new_in(move(s));
+        }, 
+        []{ 
+            String s;
+            traditional_in(move(s));
+        });
+
+    test.run(
+        "in equivalence with traditional, nontrivial prvalue", 
+        []{ 
+            new_in(String());
+        }, 
+        []{ 
+            traditional_in(String());
+        });
+
+    std::cout << test.summary();
+
+}
+
+//------------------------------------------------------------------------------
+//  One main to run them all
+
+int main() {
+    in_xtu_tests();
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <https://raw.githubusercontent.com/hsutter/misc/master/hst.h>
+
+
+//------------------------------------------------------------------------------
+//  "In" cross-TU tests: declarations only, definitions are in test-in-xtu-defs.cpp
+//
+//  Build both files together, e.g., test-in-xtu.cpp test-in-xtu-defs.cpp
+//
+//  The calling convention these tests assume, so that a declaration like the
+//  ones below can sit in a header and the definition be compiled (and the
+//  callers linked, with or without LTO) separately:
+//
+//  - "in" of a type passed by copy (trivially copyable, smaller than 8
+//    bytes) is one ordinary by-value entry point.
+//
+//  - "in" of any other type is emitted as two entry points, as if the
+//    function were written as today's const&/&& overload pair: the
+//    definition is compiled once with the parameter as const T& and once as
+//    T&&, where its definite last uses move. The caller picks the entry by
+//    the argument's value category, the same way overload resolution picks
+//    between the pair today, so whether the argument was an rvalue reaches
+//    the callee through which entry was called -- there is no hidden flag
+//    argument and nothing to test at run time. A function with N such
+//    parameters has 2^N entries, as a perfect-forwarding template would
+//    have instantiations.
+//
+//  - "inout", "move" and "out" are one entry each, passing T&, T&& and a
+//    pointer to uninitialized storage respectively.
+//
+//  Each entry mangles as the corresponding reference or value type with an
+//  Itanium vendor qualifier naming the parameter kind in front of it, so the
+//  entries of "in" never collide with a real const&/&& overload of the same
+//  name and demangle readably, e.g. for new_in below
+//
+//      _Z6new_inU2inRK6String      new_in(in String const&)    lvalue entry
+//      _Z6new_inU2inO6String       new_in(in String&&)         rvalue entry
+//
+//  (with String's own mangling spelled out in practice); int_in has the one
+//  entry _Z6int_inU2iniPi.
+
+using String = hst::noisy<std::string>;
+
+//- Built-in type --------------------------------------------------------------
+
+void int_in(in int t, int* p);
+
+//- Nontrivial concrete type ---------------------------------------------------
+
+void string_in(in String t);
+void string_in_copy(in String t);
+void string_in_copy_last(in String t);
+
+//- Comparison with traditional ------------------------------------------------
+
+void traditional_in(const String& t);
+void traditional_in(String&& t);
+void new_in(in String t);
@@ -1,5 +1,6 @@
 #include <https://raw.githubusercontent.com/hsutter/misc/master/hst.h>
 #include <iostream>
+#include <utility>
 
 
 //------------------------------------------------------------------------------
@@ -47,6 +48,53 @@ void string_in_copy_last(in String t) {
     last_use = t;       // should be a move assignment if arg is an rvalue
 }
 
+//- Nontrivial members ---------------------------------------------------------
+
+using Pair = std::pair<String, String>;
+
+//  "in+copy" of each member separately, where each member's last use is a copy
+//  attempt (which should invoke move if arg is an rvalue)
+void pair_in_copy_members(in Pair t) {
+    copy_from(t.first);     // should be a move if arg is an rvalue
+    copy_from(t.second);    // should be a move if arg is an rvalue
+}
+
+//  Same, but the first member is used twice, so only its second use can move
+void pair_in_copy_members_last(in Pair t) {
+    copy_from(t.first);     // should always be a copy
+    copy_from(t.first);     // should be a move if arg is an rvalue
+    copy_from(t.second);    // should be a move if arg is an rvalue
+}
+
+//  Same as pair_in_copy_members, but through structured bindings
+void pair_in_copy_bindings(in Pair t) {
+    auto& [first, second] = t;
+    copy_from(first);       // should be a move if arg is an rvalue
+    copy_from(second);      // should be a move if arg is an rvalue
+}
+
+//  A member use followed by a use of the whole object: the member use is not
+//  a last use, because the whole object (including that member) is used later
+void pair_in_copy_member_then_whole(in Pair t) {
+    copy_from(t.first);     // should always be a copy
+    copy_from(t);           // should be a move if arg is an rvalue
+}
+
+//  A larger record, decomposed with structured bindings: each field's last use
+//  should be a move if arg is an rvalue, saving one allocation per field
+struct Record {
+    String a, b, c, d, e;
+};
+
+void record_in_copy_bindings(in Record t) {
+    auto& [a, b, c, d, e] = t;
+    copy_from(a);           // should be a move if arg is an rvalue
+    copy_from(b);           // should be a move if arg is an rvalue
+    copy_from(c);           // should be a move if arg is an rvalue
+    copy_from(d);           // should be a move if arg is an rvalue
+    copy_from(e);           // should be a move if arg is an rvalue
+}
+
 //- Template -------------------------------------------------------------------
 
 //  Just plain "in" with no attempt to copy, function just reads its param
@@ -270,6 +318,101 @@ void in_tests() {
         "default-ctor copy-ctor dtor move-ctor dtor dtor ");
 
 
+    //------------------------------------------------------------------------------
+    // Pass nontrivial pair: each member's last use should move independently
+
+    test.run(
+        "in_copy_members with nontrivial lvalue", 
+        []{
+            Pair p;
+            pair_in_copy_members(p);
+        }, 
+        "default-ctor default-ctor copy-ctor dtor copy-ctor dtor dtor dtor ");
+
+    test.run(
+        "in_copy_members with nontrivial xvalue", 
+        []{
+            Pair p;
+            pair_in_copy_members(move(p));
+        }, 
+        "default-ctor default-ctor move-ctor dtor move-ctor dtor dtor dtor ");
+
+    test.run(
+        "in_copy_members with nontrivial prvalue", 
+        []{
+            pair_in_copy_members(Pair());
+        }, 
+        "default-ctor default-ctor move-ctor dtor move-ctor dtor dtor dtor ");
+
+    test.run(
+        "in_copy_members_last with nontrivial xvalue", 
+        []{
+            Pair p;
+            pair_in_copy_members_last(move(p));
+        }, 
+        "default-ctor default-ctor copy-ctor dtor move-ctor dtor move-ctor dtor dtor dtor ");
+
+    test.run(
+        "in_copy_bindings with nontrivial lvalue", 
+        []{
+            Pair p;
+            pair_in_copy_bindings(p);
+        }, 
+        "default-ctor default-ctor copy-ctor dtor copy-ctor dtor dtor dtor ");
+
+    test.run(
+        "in_copy_bindings with nontrivial xvalue", 
+        []{
+            Pair p;
+            pair_in_copy_bindings(move(p));
+        }, 
+        "default-ctor default-ctor move-ctor dtor move-ctor dtor dtor dtor ");
+
+    test.run(
+        "in_copy_bindings with nontrivial prvalue", 
+        []{
+            pair_in_copy_bindings(Pair());
+        }, 
+        "default-ctor default-ctor move-ctor dtor move-ctor dtor dtor dtor ");
+
+    test.run(
+        "in_copy_member_then_whole with nontrivial xvalue", 
+        []{
+            Pair p;
+            pair_in_copy_member_then_whole(move(p));
+        }, 
+        "default-ctor default-ctor copy-ctor dtor move-ctor move-ctor dtor dtor dtor dtor ");
+
+    test.run(
+        "record in_copy_bindings with nontrivial lvalue", 
+        []{
+            Record r;
+            record_in_copy_bindings(r);
+        }, 
+        "default-ctor default-ctor default-ctor default-ctor default-ctor "
+        "copy-ctor dtor copy-ctor dtor copy-ctor dtor copy-ctor dtor copy-ctor dtor "
+        "dtor dtor dtor dtor dtor ");
+
+    test.run(
+        "record in_copy_bindings with nontrivial xvalue", 
+        []{
+            Record r;
+            record_in_copy_bindings(std::move(r));   // Record is not in std, so no ADL
+        }, 
+        "default-ctor default-ctor default-ctor default-ctor default-ctor "
+        "move-ctor dtor move-ctor dtor move-ctor dtor move-ctor dtor move-ctor dtor "
+        "dtor dtor dtor dtor dtor ");
+
+    test.run(
+        "record in_copy_bindings with nontrivial prvalue", 
+        []{
+            record_in_copy_bindings(Record());
+        }, 
+        "default-ctor default-ctor default-ctor default-ctor default-ctor "
+        "move-ctor dtor move-ctor dtor move-ctor dtor move-ctor dtor move-ctor dtor "
+        "dtor dtor dtor dtor dtor ");
+
+
     //------------------------------------------------------------------------------
     // Compare traditional_in and new_in
 
@@ -23,6 +23,24 @@ void int_inout(inout int t, int* p) {
     modify(t);
 }
 
+//  Just plain "inout" in a tight loop, where copy-in/copy-out would let the
+//  caller keep the variable in a register
+void int_increment(inout int t) {
+    modify(t);
+}
+
+//  Two "inout" parameters that may refer to the same object
+void int_inout_both(inout int a, inout int b) {
+    modify(a);
+    modify(b);
+}
+
+//  An "inout" parameter whose object is also read through another path
+void int_inout_observe(inout int t, const int* p) {
+    modify(t);
+    hst::history += std::to_string(*p) + " ";
+}
+
 //- Nontrivial concrete type ---------------------------------------------------
 
 using String = hst::noisy<std::string>;
@@ -114,6 +132,37 @@ void inout_tests() {
         }, 
         "pass-by-pointer 1");
 
+    //------------------------------------------------------------------------------
+    // Trivial lvalue observable semantics: the same whether the implementation
+    // passes by pointer, or (where nothing aliases) copies in and back out
+
+    test.run(
+        "inout with trivial lvalue, repeated calls", 
+        []{
+            int i = 0;
+            for (int n = 0; n < 3; ++n) { int_increment(i); }
+            hst::history += std::to_string(i);
+        }, 
+        "3");
+
+    test.run(
+        "inout with trivial lvalue, same object twice", 
+        []{
+            int i = 0;
+            int_inout_both(i, i);
+            hst::history += std::to_string(i);
+        }, 
+        "2");   // both increments are seen, so not copied in and out separately
+
+    test.run(
+        "inout with trivial lvalue, read through alias during call", 
+        []{
+            int i = 0;
+            int_inout_observe(i, &i);
+            hst::history += std::to_string(i);
+        }, 
+        "1 1"); // the write is visible through the alias before the call returns
+
     //------------------------------------------------------------------------------
     // Pass nontrivial lvalue: Should pass by ptr/ref, then copy inside string_inout_copy*
 
@@ -7,6 +7,76 @@ using X = hst::noisy<std::string>;
 void f_old(X&& x) { copy_from(std::move(x)); }
 void f_new(move X x) { copy_from(x); }
 
+//  A "move" parameter must be moved from on every path, so each branch's last
+//  use is a move
+void f_old_branches(X&& x) {
+    if (rand()%2) { copy_from(std::move(x)); }
+    else          { copy_from(std::move(x)); }
+}
+void f_new_branches(move X x) {
+    if (rand()%2) { copy_from(x); }
+    else          { copy_from(x); }
+}
+
+//  Earlier uses are reads, only the last use on each path is the move
+void f_old_read_first(X&& x) { copy_from(x); copy_from(std::move(x)); }
+void f_new_read_first(move X x) { copy_from(x); copy_from(x); }
+
+//  Each of these should be rejected at compile time, because "x" is not moved
+//  from on every path. Each one is compiled only when MOVE_EXPECT_ERROR names
+//  it, so a script can check that the file compiles as is and that each case
+//  does not, e.g.:
+//
+//      clang++ -std=c++20 -fsyntax-only test-move.cpp || echo "test-move.cpp does not compile"
+//      for n in 1 2 3; do
+//          clang++ -std=c++20 -fsyntax-only -DMOVE_EXPECT_ERROR=$n test-move.cpp 2>/dev/null &&
+//              echo "MOVE_EXPECT_ERROR=$n compiled, but should have been rejected"
+//      done
+//
+#if MOVE_EXPECT_ERROR == 1
+void f_new_never_moved(move X x) { (void)x; }                       // no move at all
+#elif MOVE_EXPECT_ERROR == 2
+void f_new_one_path(move X x) { if (rand()%2) { copy_from(x); } }   // else path does not move
+#elif MOVE_EXPECT_ERROR == 3
+void f_new_read_last(move X x) { copy_from(x); (void)x.t; }         // last use is a read, not a move
+#endif
+
+
+//------------------------------------------------------------------------------
+//  Debug aid: an X that remembers being moved from, and writes
+//  "read-after-move" to the history whenever it is read after that, until it
+//  is assigned a new value
+
+class poisoned {
+    X    x;
+    bool moved_from = false;
+public:
+    poisoned() = default;
+    poisoned(const poisoned& that) : x(that.read()) { }
+    poisoned(poisoned&& that) noexcept : x(std::move(that.read_to_move())) { }
+    poisoned& operator=(const poisoned& that) { x = that.read(); moved_from = false; return *this; }
+    poisoned& operator=(poisoned&& that) noexcept { x = std::move(that.read_to_move()); moved_from = false; return *this; }
+
+    const X& read() const {
+        if (moved_from) { hst::history += "read-after-move "; }
+        return x;
+    }
+    X& read_to_move() {
+        (void)read();
+        moved_from = true;
+        return x;
+    }
+};
+
+void p_old(poisoned&& p) { copy_from(std::move(p)); }
+void p_new(move poisoned p) { copy_from(p); }
+
+void p_old_read_first(poisoned&& p) { copy_from(p); copy_from(std::move(p)); }
+void p_new_read_first(move poisoned p) { copy_from(p); copy_from(p); }
+
+
+#ifndef COMPARE_CODEGEN
+
 int main() {
     hst::tester test("move parameter cases");
 
@@ -30,6 +100,103 @@ int main() {
             f_old(X());
         });
 
+    test.run(
+        "lvalue test", 
+        []{
+            X x;
+            HST_CAN_INVOKE(f_new)(x);
+        }, 
+        "default-ctor cannot-invoke dtor ");    // i.e., a "move" parameter does not bind to an lvalue
+
+    test.run(
+        "xvalue test, move on every branch", 
+        []{
+            X x;
+            f_new_branches(std::move(x));
+        }, 
+        []{
+            X x;
+            f_old_branches(std::move(x));
+        });
+
+    test.run(
+        "prvalue test, move on every branch", 
+        []{
+            f_new_branches(X());
+        }, 
+        []{
+            f_old_branches(X());
+        });
+
+    test.run(
+        "xvalue test, read then move", 
+        []{
+            X x;
+            f_new_read_first(std::move(x));
+        }, 
+        []{
+            X x;
+            f_old_read_first(std::move(x));
+        });
+
+    test.run(
+        "xvalue test, poisoned, callee never reads after its move", 
+        []{
+            poisoned p;
+            p_new_read_first(std::move(p));
+        }, 
+        []{
+            poisoned p;
+            p_old_read_first(std::move(p));
+        });
+
+    test.run(
+        "xvalue test, poisoned, caller reads after the move", 
+        []{
+            poisoned p;
+            p_new(std::move(p));
+            (void)p.read();
+        }, 
+        "default-ctor move-ctor dtor read-after-move dtor ");   // i.e., p really was moved from
+
     std::cout << test.summary();
 
 }
+
+#else
+
+//------------------------------------------------------------------------------
+//  Release codegen check: build with -O2 -DCOMPARE_CODEGEN -S and run asm-diff
+//  on the result, which reports how each old/new pair's generated code
+//  differs (the pairs are the same as the test cases above)
+
+[[gnu::noinline]] void out_of_line(auto f) { f(); }
+
+void compare(auto name, auto f1, auto f2) {
+    std::cout << name << "\n  old: " << hst::run_history([=]{ out_of_line(f1); })
+                      << "\n  new: " << hst::run_history([=]{ out_of_line(f2); }) << "\n\n";
+}
+
+int main() {
+    compare("xvalue",
+            []{ X x;   f_old(std::move(x));              },
+            []{ X x;   f_new(std::move(x));              });
+
+    compare("prvalue",
+            []{        f_old(X());                       },
+            []{        f_new(X());                       });
+
+    compare("xvalue, move on every branch",
+            []{ X x;   f_old_branches(std::move(x));     },
+            []{ X x;   f_new_branches(std::move(x));     });
+
+    compare("prvalue, move on every branch",
+            []{        f_old_branches(X());              },
+            []{        f_new_branches(X());              });
+
+    compare("xvalue, read then move",
+            []{ X x;   f_old_read_first(std::move(x));   },
+            []{ X x;   f_new_read_first(std::move(x));   });
+}
+
+#endif
@@ -0,0 +1,154 @@
+#include <https://raw.githubusercontent.com/hsutter/misc/master/hst.h>
+#include <iostream>
+#include <string>
+#include <utility>
+#include "timing.h"
+
+
+//------------------------------------------------------------------------------
+//  Debug-build cost of parameter passing: build this at -O0 (the way the test
+//  suite is usually run) and compare the per-call times. At -O0 every
+//  std::forward/std::move is a real function call, so today's perfect-
+//  forwarding spelling pays for one per argument; the "in" lowering should
+//  be a direct cast with no helper calls, as cheap as the static_cast line.
+//
+//  The six-parameter comparison uses plain std::string, so that it measures
+//  only the parameter passing. The test-in.cpp matrix is timed as is, with
+//  hst::noisy and its history bookkeeping, since that is what a debug run of
+//  the test suite actually pays.
+//
+//------------------------------------------------------------------------------
+
+std::size_t sink = 0;
+
+void copy_from(auto const&... ts) { ((sink += ts.size()), ...); }
+
+struct sized_int { int i; auto size() const { return std::size_t(i); } };
+
+
+//  Today's way, perfect forwarding with std::forward
+template<typename A, typename B, typename C, typename D, typename E, typename F>
+void old_in(A&& a, B&& b, C&& c, D&& d, E&& e, F&& f) {
+    copy_from(std::forward<A>(a), std::forward<B>(b));
+    copy_from(std::forward<C>(c));
+    copy_from(std::forward<D>(d), std::forward<E>(e), std::forward<F>(f));
+}
+
+//  Today's way, but with the casts written out -- what "in" should cost
+template<typename A, typename B, typename C, typename D, typename E, typename F>
+void cast_in(A&& a, B&& b, C&& c, D&& d, E&& e, F&& f) {
+    copy_from(static_cast<A&&>(a), static_cast<B&&>(b));
+    copy_from(static_cast<C&&>(c));
+    copy_from(static_cast<D&&>(d), static_cast<E&&>(e), static_cast<F&&>(f));
+}
+
+//  Proposed way, same body as demo-in-5.cpp
+void new_in(in auto a, in auto b, in auto c, in auto d, in auto e, in auto f) {
+    copy_from(a, b);
+    copy_from(c);
+    copy_from(d, e, f);
+}
+
+
+//------------------------------------------------------------------------------
+//  The test-in.cpp matrix: same functions and calls as there
+
+namespace matrix {
+
+template<typename T>
+void copy_from(T) { }
+
+using String = hst::noisy<std::string>;
+
+void int_in(in int t, int* p) {
+    hst::history += &t==p ? "pass-by-pointer " : "pass-by-copy ";
+}
+
+void string_in(in String t) {
+    (void)t;
+}
+
+void string_in_copy(in String t) {
+    String local;
+    local = t;
+}
+
+void string_in_copy_last(in String t) {
+    if (rand()%2) {
+        String local;
+        local = t;
+    } else {
+        String local2;
+        local2 = t;
+    }
+    String last_use;
+    last_use = t;
+}
+
+template<typename T>
+void t_in(in T t) {
+    (void)t;
+}
+
+template<typename T>
+void t_in_copy(in T t) {
+    copy_from(t);
+}
+
+template<typename T>
+void t_in_copy_last(in T t) {
+    if (rand()%2) {
+        copy_from(t);
+    } else {
+        copy_from(t);
+    }
+    copy_from(t);
+}
+
+//  Each case clears the history first, as hst::run_history does
+void run_all() {
+    int i = 0;
+    String s;
+
+    hst::history = {};  int_in(i, &i);
+    hst::history = {};  string_in(s);
+    hst::history = {};  string_in_copy(s);
+    hst::history = {};  string_in_copy_last(s);
+    hst::history = {};  t_in(s);
+    hst::history = {};  t_in_copy(s);
+    hst::history = {};  t_in_copy_last(s);
+
+    hst::history = {};  { String x;  string_in(std::move(x)); }
+    hst::history = {};  { String x;  string_in_copy(std::move(x)); }
+    hst::history = {};  { String x;  string_in_copy_last(std::move(x)); }
+    hst::history = {};  { String x;  t_in(std::move(x)); }
+    hst::history = {};  { String x;  t_in_copy(std::move(x)); }
+    hst::history = {};  { String x;  t_in_copy_last(std::move(x)); }
+
+    hst::history = {};  string_in(String());
+    hst::history = {};  string_in_copy(String());
+    hst::history = {};  string_in_copy_last(String());
+    hst::history = {};  t_in(String());
+    hst::history = {};  t_in_copy(String());
+    hst::history = {};  t_in_copy_last(String());
+}
+
+}
+
+
+int main() {
+    constexpr long iterations = 1'000'000;
+
+    sized_int i{1};
+    std::string s(64, 'x'), s2(64, 'x'), s3(64, 'x');
+
+    //  Same argument mix as demo-in-5.cpp: lvalues, an xvalue, and prvalues --
+    //  the xvalue is never actually moved from, since copy_from only reads
+    timing::time("old_in  (std::forward)", iterations, [&]{ old_in (i, s, std::move(s2), s3, sized_int{42}, std::string()); });
+    timing::time("cast_in (static_cast) ", iterations, [&]{ cast_in(i, s, std::move(s2), s3, sized_int{42}, std::string()); });
+    timing::time("new_in  (in)          ", iterations, [&]{ new_in (i, s, std::move(s2), s3, sized_int{42}, std::string()); });
+
+    timing::time("test-in.cpp matrix    ", iterations, []{ matrix::run_all(); });
+
+    std::cout << "(checksum " << sink << ")\n";
+}
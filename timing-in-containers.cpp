@@ -0,0 +1,58 @@
+#include <cstdlib>
+#include <deque>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "in-containers.h"
+#include "timing.h"
+
+
+//------------------------------------------------------------------------------
+//  Insertion throughput of std::string keys: the "in" container wrappers from
+//  in-containers.h against std::vector/std::deque/std::unordered_map called
+//  directly, for lvalue (copied) and rvalue (moved) keys. The two should be
+//  at parity, since each "in" mutator should do exactly what the matching
+//  const&/&& overload does.
+//
+//  Takes the number of keys as its argument (default 10000000).
+//
+//------------------------------------------------------------------------------
+
+//  Time one pass over fresh keys; "make" builds the container, "insert" adds
+//  one key to it. Key generation is outside the timed region.
+void time_inserts(auto name, std::size_t count, auto make, auto insert) {
+    auto keys = std::vector<std::string>{};
+    keys.reserve(count);
+    for (auto i = std::size_t{0}; i < count; ++i) {
+        keys.push_back("key number " + std::to_string(i) + " long enough to allocate");
+    }
+    auto c = make();
+    auto sw = timing::stopwatch{};
+    for (auto& k : keys) { insert(c, k); }
+    timing::print(name, sw.ns() / count, "ns/insert");
+}
+
+int main(int argc, char* argv[]) {
+    auto count = std::size_t(argc > 1 ? std::atoll(argv[1]) : 10'000'000);
+
+    auto in_vec  = [&]{ in_vector<std::string> v;  v.reserve(count);  return v; };
+    auto std_vec = [&]{ std::vector<std::string> v;  v.reserve(count);  return v; };
+    auto in_deq  = []{ return in_deque<std::string>{}; };
+    auto std_deq = []{ return std::deque<std::string>{}; };
+    auto in_map  = [&]{ in_hash_map<std::string, int> m;  m.reserve(count);  return m; };
+    auto std_map = [&]{ std::unordered_map<std::string, int> m;  m.reserve(count);  return m; };
+
+    time_inserts("in_vector          push_back   lvalue", count, in_vec,  [](auto& v, auto& k){ v.push_back(k); });
+    time_inserts("std::vector        push_back   lvalue", count, std_vec, [](auto& v, auto& k){ v.push_back(k); });
+    time_inserts("in_vector          push_back   rvalue", count, in_vec,  [](auto& v, auto& k){ v.push_back(std::move(k)); });
+    time_inserts("std::vector        push_back   rvalue", count, std_vec, [](auto& v, auto& k){ v.push_back(std::move(k)); });
+    time_inserts("in_deque           push_back   lvalue", count, in_deq,  [](auto& d, auto& k){ d.push_back(k); });
+    time_inserts("std::deque         push_back   lvalue", count, std_deq, [](auto& d, auto& k){ d.push_back(k); });
+    time_inserts("in_deque           push_back   rvalue", count, in_deq,  [](auto& d, auto& k){ d.push_back(std::move(k)); });
+    time_inserts("std::deque         push_back   rvalue", count, std_deq, [](auto& d, auto& k){ d.push_back(std::move(k)); });
+    time_inserts("in_hash_map        insert      lvalue", count, in_map,  [](auto& m, auto& k){ m.insert(k, 0); });
+    time_inserts("std::unordered_map try_emplace lvalue", count, std_map, [](auto& m, auto& k){ m.try_emplace(k, 0); });
+    time_inserts("in_hash_map        insert      rvalue", count, in_map,  [](auto& m, auto& k){ m.insert(std::move(k), 0); });
+    time_inserts("std::unordered_map try_emplace rvalue", count, std_map, [](auto& m, auto& k){ m.try_emplace(std::move(k), 0); });
+}
@@ -0,0 +1,51 @@
+#include <string>
+#include <utility>
+#include <vector>
+#include "timing.h"
+
+
+//------------------------------------------------------------------------------
+//  Cost of growing a std::vector of a type whose constructor takes an "in"
+//  parameter, against the same type with today's const&/&& constructor pair.
+//  Both types' move constructors delegate to the parameter constructor, so
+//  the vector relocates by move only if the "in" constructor's noexcept is
+//  deduced for rvalues; if it isn't, every reallocation copies every string.
+//
+//------------------------------------------------------------------------------
+
+struct new_widget {
+    std::string s;
+    new_widget(in std::string s_) : s(s_) { }
+    new_widget(const new_widget& that) : new_widget(that.s) { }
+    new_widget(new_widget&& that) noexcept(noexcept(new_widget(std::move(that.s))))
+        : new_widget(std::move(that.s)) { }
+};
+
+struct old_widget {
+    std::string s;
+    old_widget(const std::string& s_) : s(s_) { }
+    old_widget(std::string&& s_) noexcept : s(std::move(s_)) { }
+    old_widget(const old_widget& that) : old_widget(that.s) { }
+    old_widget(old_widget&& that) noexcept(noexcept(old_widget(std::move(that.s))))
+        : old_widget(std::move(that.s)) { }
+};
+
+
+//  One batch is 100k emplace_backs into an empty vector
+template<typename Widget>
+void time_growth(auto name) {
+    constexpr int iterations = 100, elements = 100'000;
+    auto sw = timing::stopwatch{};
+    for (int n = 0; n < iterations; ++n) {
+        std::vector<Widget> v;      // no reserve, so it reallocates as it grows
+        for (int i = 0; i < elements; ++i) {
+            v.emplace_back(std::string(64, 'x'));
+        }
+    }
+    timing::print(name, sw.ns() / 1000 / iterations, "us/batch");
+}
+
+int main() {
+    time_growth<new_widget>("in constructor        ");
+    time_growth<old_widget>("const&/&& constructors");
+}
@@ -0,0 +1,82 @@
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include "timing.h"
+
+
+//------------------------------------------------------------------------------
+//  Cost of passing 1 MB batches through a 4-stage pipeline: "in" stages
+//  against today's const&/&& stage pairs, for lvalue (copied once, at the
+//  end) and rvalue (never copied) batches. Then the same for an elementwise
+//  sink, which pushes each element of the batch into its output (each one
+//  copied for an lvalue batch, moved for an rvalue). Counts element copies
+//  as well as time, via a string wrapper that counts its copy constructions.
+//
+//------------------------------------------------------------------------------
+
+std::size_t copies = 0;
+
+struct counted {
+    std::string s;
+    counted() = default;
+    counted(const counted& that) : s(that.s) { ++copies; }
+    counted(counted&&) noexcept = default;
+    counted& operator=(const counted& that) { s = that.s; ++copies; return *this; }
+    counted& operator=(counted&&) noexcept = default;
+};
+
+using Batch = std::vector<counted>;
+
+void stage4(in Batch b, inout Batch out) { out = b; }
+void stage3(in Batch b, inout Batch out) { (void)b.size(); stage4(b, out); }
+void stage2(in Batch b, inout Batch out) { (void)b.size(); stage3(b, out); }
+void stage1(in Batch b, inout Batch out) { (void)b.size(); stage2(b, out); }
+
+void old_stage4(const Batch& b, Batch& out) { out = b; }
+void old_stage4(Batch&& b,      Batch& out) { out = std::move(b); }
+void old_stage3(const Batch& b, Batch& out) { (void)b.size(); old_stage4(b, out); }
+void old_stage3(Batch&& b,      Batch& out) { (void)b.size(); old_stage4(std::move(b), out); }
+void old_stage2(const Batch& b, Batch& out) { (void)b.size(); old_stage3(b, out); }
+void old_stage2(Batch&& b,      Batch& out) { (void)b.size(); old_stage3(std::move(b), out); }
+void old_stage1(const Batch& b, Batch& out) { (void)b.size(); old_stage2(b, out); }
+void old_stage1(Batch&& b,      Batch& out) { (void)b.size(); old_stage2(std::move(b), out); }
+
+//  Elementwise sink, same as in test-in-ranges.cpp
+void stage_elements(in Batch b, inout Batch out) {
+    for (auto&& e : b) { out.push_back(e); }
+}
+
+void old_stage_elements(const Batch& b, Batch& out) { for (auto& e : b) { out.push_back(e); } }
+void old_stage_elements(Batch&& b,      Batch& out) { for (auto& e : b) { out.push_back(std::move(e)); } }
+
+
+//  About 1 MB of string data per batch
+Batch make_batch() {
+    auto b = Batch(1024);
+    for (auto& e : b) { e.s.assign(1024, 'x'); }
+    return b;
+}
+
+void time_batches(std::string_view name, auto f) {
+    constexpr int iterations = 200;
+    auto batches = std::vector<Batch>(iterations, make_batch());
+    copies = 0;
+    auto sw = timing::stopwatch{};
+    for (auto& b : batches) { f(b); }
+    timing::print(name, sw.ns() / 1000 / iterations, "us/batch");
+    timing::print(name, double(copies) / iterations, "copies/batch");
+}
+
+int main() {
+    time_batches("lvalue, in", [](Batch& b){ Batch out; stage1(b, out); });
+    time_batches("lvalue, const&/&&", [](Batch& b){ Batch out; old_stage1(b, out); });
+    time_batches("rvalue, in", [](Batch& b){ Batch out; stage1(std::move(b), out); });
+    time_batches("rvalue, const&/&&", [](Batch& b){ Batch out; old_stage1(std::move(b), out); });
+
+    //  The output is reserved up front, so that only the elements are timed
+    time_batches("elementwise, lvalue, in", [](Batch& b){ Batch out; out.reserve(b.size()); stage_elements(b, out); });
+    time_batches("elementwise, lvalue, const&/&&", [](Batch& b){ Batch out; out.reserve(b.size()); old_stage_elements(b, out); });
+    time_batches("elementwise, rvalue, in", [](Batch& b){ Batch out; out.reserve(b.size()); stage_elements(std::move(b), out); });
+    time_batches("elementwise, rvalue, const&/&&", [](Batch& b){ Batch out; out.reserve(b.size()); old_stage_elements(std::move(b), out); });
+}
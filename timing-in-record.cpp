@@ -0,0 +1,52 @@
+#include <string>
+#include <utility>
+#include "timing.h"
+
+
+//------------------------------------------------------------------------------
+//  Cost of decomposing a large record (5 string fields) passed "in", where
+//  each field's last use through a structured binding should be a move for
+//  an rvalue argument -- saving 5 allocations per call against reading the
+//  record through const& and copying each field.
+//
+//------------------------------------------------------------------------------
+
+struct Record {
+    std::string a, b, c, d, e;
+};
+
+struct Sink {
+    std::string a, b, c, d, e;
+};
+
+[[gnu::noinline]] void new_in(in Record r, Sink& out) {
+    auto& [a, b, c, d, e] = r;
+    out.a = a;  out.b = b;  out.c = c;  out.d = d;  out.e = e;     // moves if arg is an rvalue
+}
+
+[[gnu::noinline]] void old_const_ref(const Record& r, Sink& out) {
+    auto& [a, b, c, d, e] = r;
+    out.a = a;  out.b = b;  out.c = c;  out.d = d;  out.e = e;     // always copies
+}
+
+[[gnu::noinline]] void old_rvalue_ref(Record&& r, Sink& out) {
+    auto& [a, b, c, d, e] = r;
+    out.a = std::move(a);  out.b = std::move(b);  out.c = std::move(c);
+    out.d = std::move(d);  out.e = std::move(e);
+}
+
+
+void time_calls(auto name, auto f) {
+    auto const field = std::string(256, 'x');
+    timing::time(name, 1'000'000, [&]{
+        auto out = Sink{};      // empty each time, so a copied field has to allocate
+        f(Record{ field, field, field, field, field }, out);
+    });
+}
+
+int main() {
+    //  Each iteration makes a fresh rvalue record, which costs the same for all
+    time_calls("rvalue, in                ", [](Record&& r, Sink& out){ new_in(std::move(r), out); });
+    time_calls("rvalue, const& (copies)   ", [](Record&& r, Sink& out){ old_const_ref(r, out); });
+    time_calls("rvalue, && (hand-written) ", [](Record&& r, Sink& out){ old_rvalue_ref(std::move(r), out); });
+}
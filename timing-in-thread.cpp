@@ -0,0 +1,102 @@
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "timing.h"
+
+
+//------------------------------------------------------------------------------
+//  Cost of launching 100k tasks with 4 KB string payloads on a local thread
+//  pool, with an "in" entry point against today's by-value sink. Like
+//  std::thread, the pool decay-copies each argument into the task, so an
+//  rvalue payload should reach an "in" entry point with no copies, and an
+//  lvalue payload with one.
+//
+//------------------------------------------------------------------------------
+
+class thread_pool {
+    std::mutex                        m;
+    std::condition_variable_any       cv;      // waits on the threads' stop tokens too
+    std::deque<std::function<void()>> tasks;
+    std::size_t                       pending = 0;
+    std::condition_variable           idle;
+    std::vector<std::jthread>         threads;
+
+public:
+    thread_pool(unsigned n = std::thread::hardware_concurrency()) {
+        for (auto i = 0u; i < std::max(n, 1u); ++i) {
+            threads.emplace_back([this](std::stop_token stop) {
+                for (;;) {
+                    auto task = std::function<void()>{};
+                    {
+                        auto lock = std::unique_lock(m);
+                        cv.wait(lock, stop, [this]{ return !tasks.empty(); });
+                        if (tasks.empty()) { return; }
+                        task = std::move(tasks.front());
+                        tasks.pop_front();
+                    }
+                    task();
+                    auto lock = std::lock_guard(m);
+                    if (--pending == 0) { idle.notify_all(); }
+                }
+            });
+        }
+    }
+
+    //  Arguments are decay-copied into the task, as std::thread does, and
+    //  passed on to f as rvalues
+    void submit(auto f, auto... args) {
+        {
+            auto lock = std::lock_guard(m);
+            tasks.emplace_back([f, ...args = std::move(args)]() mutable { f(std::move(args)...); });
+            ++pending;
+        }
+        cv.notify_one();
+    }
+
+    void wait() {
+        auto lock = std::unique_lock(m);
+        idle.wait(lock, [this]{ return pending == 0; });
+    }
+};
+
+std::atomic<std::size_t> sink = 0;
+
+void worker_in(in std::string s) {
+    std::string local = s;          // a move if arg is an rvalue
+    sink += local.size();
+}
+
+void worker_byvalue(std::string s) {
+    std::string local = std::move(s);
+    sink += local.size();
+}
+
+
+void time_tasks(auto name, thread_pool& pool, auto submit) {
+    constexpr int tasks = 100'000;
+    auto const payload = std::string(4096, 'x');
+    auto sw = timing::stopwatch{};
+    for (int n = 0; n < tasks; ++n) { submit(pool, payload); }
+    pool.wait();
+    timing::print(name, sw.ns() / tasks, "ns/task");
+}
+
+int main() {
+    auto pool = thread_pool{};
+
+    //  The rvalue cases include making the payload, which costs the same for all
+    time_tasks("rvalue, in           ", pool, [](auto& p, auto const& s){ auto c = s; p.submit(worker_in, std::move(c)); });
+    time_tasks("rvalue, by-value sink", pool, [](auto& p, auto const& s){ auto c = s; p.submit(worker_byvalue, std::move(c)); });
+    time_tasks("lvalue, in           ", pool, [](auto& p, auto const& s){ p.submit(worker_in, s); });
+    time_tasks("lvalue, by-value sink", pool, [](auto& p, auto const& s){ p.submit(worker_byvalue, s); });
+
+    std::cout << "(checksum " << sink << ")\n";
+}
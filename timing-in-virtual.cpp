@@ -0,0 +1,63 @@
+#include <memory>
+#include <string>
+#include <utility>
+#include "timing.h"
+
+
+//------------------------------------------------------------------------------
+//  Cost of virtual dispatch with 1 KB string arguments: an "in" virtual
+//  against today's by-value sink idiom and the const&/&& virtual overload
+//  pair. Each override stores its argument, so an rvalue caller should get a
+//  move through the indirect call (no allocation) and an lvalue caller one
+//  copy; the by-value sink pays an extra move for both.
+//
+//------------------------------------------------------------------------------
+
+struct new_base {
+    virtual void sink(in std::string t) = 0;
+    virtual ~new_base() = default;
+};
+struct new_derived : new_base {
+    std::string stored;
+    void sink(in std::string t) override { stored = t; }   // a move if arg is an rvalue
+};
+
+struct byvalue_base {
+    virtual void sink(std::string t) = 0;
+    virtual ~byvalue_base() = default;
+};
+struct byvalue_derived : byvalue_base {
+    std::string stored;
+    void sink(std::string t) override { stored = std::move(t); }
+};
+
+struct pair_base {
+    virtual void sink(const std::string& t) = 0;
+    virtual void sink(std::string&& t) = 0;
+    virtual ~pair_base() = default;
+};
+struct pair_derived : pair_base {
+    std::string stored;
+    void sink(const std::string& t) override { stored = t; }
+    void sink(std::string&& t) override { stored = std::move(t); }
+};
+
+
+int main() {
+    constexpr long iterations = 1'000'000;
+
+    //  Allocated behind a pointer so the calls stay indirect
+    std::unique_ptr<new_base>     n = std::make_unique<new_derived>();
+    std::unique_ptr<byvalue_base> b = std::make_unique<byvalue_derived>();
+    std::unique_ptr<pair_base>    p = std::make_unique<pair_derived>();
+
+    auto const payload = std::string(1024, 'x');
+
+    //  The rvalue cases include making the argument, which costs the same for all
+    timing::time("rvalue, in               ", iterations, [&]{ auto s = payload; n->sink(std::move(s)); });
+    timing::time("rvalue, by-value sink    ", iterations, [&]{ auto s = payload; b->sink(std::move(s)); });
+    timing::time("rvalue, const&/&& pair   ", iterations, [&]{ auto s = payload; p->sink(std::move(s)); });
+    timing::time("lvalue, in               ", iterations, [&]{ n->sink(payload); });
+    timing::time("lvalue, by-value sink    ", iterations, [&]{ b->sink(payload); });
+    timing::time("lvalue, const&/&& pair   ", iterations, [&]{ p->sink(payload); });
+}
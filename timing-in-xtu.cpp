@@ -0,0 +1,28 @@
+#include "test-in-xtu.h"
+#include "timing.h"
+
+
+//------------------------------------------------------------------------------
+//  Cost of a cross-TU "in" call: new_in against the traditional_in const&/&&
+//  pair, both defined in test-in-xtu-defs.cpp, so neither can be inlined
+//  into the loop. Build the two files together without -flto, e.g.:
+//
+//      clang++ -std=c++20 -O2 timing-in-xtu.cpp test-in-xtu-defs.cpp
+//
+//  With the two-entry convention in test-in-xtu.h, each "in" call should
+//  cost the same as the matching traditional overload.
+//
+//------------------------------------------------------------------------------
+
+int main() {
+    constexpr long iterations = 1'000'000;
+
+    auto const s = String();
+
+    //  Each call clears hst::history, so that it doesn't grow across calls;
+    //  that and making the rvalue argument cost the same for both
+    timing::time("lvalue, in       ", iterations, [&]{ hst::history.clear(); new_in(s); });
+    timing::time("lvalue, const&/&&", iterations, [&]{ hst::history.clear(); traditional_in(s); });
+    timing::time("rvalue, in       ", iterations, [&]{ hst::history.clear(); new_in(String()); });
+    timing::time("rvalue, const&/&&", iterations, [&]{ hst::history.clear(); traditional_in(String()); });
+}
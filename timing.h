@@ -0,0 +1,37 @@
+#pragma once
+
+#include <chrono>
+#include <iostream>
+#include <string_view>
+
+
+//------------------------------------------------------------------------------
+//  Shared helpers for the timing-*.cpp programs (see README.md for the list
+//  and how to build them). Every result is printed as one line of the form
+//
+//      <name>: <value> <unit>
+//
+//  which is also the shape report reads into its per-build metrics.
+
+namespace timing {
+
+//  Elapsed time since construction
+class stopwatch {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+public:
+    double ns() const { return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count(); }
+};
+
+//  Print one result line
+inline void print(std::string_view name, double value, std::string_view unit) {
+    std::cout << name << ": " << value << " " << unit << "\n";
+}
+
+//  Run f() the given number of times and print the average time per call
+void time(std::string_view name, long iterations, auto f) {
+    auto sw = stopwatch{};
+    for (long n = 0; n < iterations; ++n) { f(); }
+    print(name, sw.ns() / iterations, "ns/call");
+}
+
+}